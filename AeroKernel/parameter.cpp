@@ -9,6 +9,7 @@
  ********************************************************************************/
 
 /* C++ Includes */
+#include <algorithm>
 #include <type_traits>
 
 #include <AeroKernel/parameter.hpp>
@@ -18,7 +19,7 @@ namespace AeroKernel::Parameter
   namespace Location
   {
     static constexpr uint8_t MEM_LOC_POS = 0u;                 /**< ParamCtrlBlk.config bit position for memory locator */
-    static constexpr uint8_t MEM_LOC_MSK = 0x7 << MEM_LOC_POS; /**< Memory locator config bit width mask */
+    static constexpr uint8_t MEM_LOC_MSK = 0xF << MEM_LOC_POS; /**< Memory locator config bit width mask */
 
     static constexpr size_t INVALID              = 0u;
     static constexpr size_t INTERNAL_SRAM        = 1u << MEM_LOC_POS; /**< Location option for internal SRAM */
@@ -36,179 +37,3562 @@ namespace AeroKernel::Parameter
   Compile Time Checks
   ------------------------------------------------*/
   static_assert( static_cast<uint8_t>( Location::MAX_MEMORY_LOCATIONS ) == 8, "Incorrect supported memory locations" );
+  static_assert( ( Location::EXTERNAL_SRAM2 & Location::MEM_LOC_MSK ) == Location::EXTERNAL_SRAM2, "Memory locator mask too narrow" );
 
+  namespace Placement
+  {
+    static constexpr uint32_t GROUP_POS  = 4u;                                   /**< ParamCtrlBlk.config bit position for the placement group */
+    static constexpr uint32_t GROUP_MSK  = 0xFu << GROUP_POS;                    /**< Placement group bit width mask */
+    static constexpr uint32_t MANUAL_POS = 8u;                                   /**< ParamCtrlBlk.config bit position for the user placed flag */
+    static constexpr uint32_t MANUAL_MSK = 1u << MANUAL_POS;                     /**< Cleared once the Manager has chosen the address */
+    static constexpr uint32_t UNSET      = std::numeric_limits<uint32_t>::max(); /**< Address of a parameter with no home yet */
+  }  // namespace Placement
+
+  static_assert( ( Placement::GROUP_MSK & Location::MEM_LOC_MSK ) == 0u, "Placement group overlaps the memory locator" );
+
+  namespace Tier
+  {
+    static constexpr uint32_t PROMOTED_POS = 9u;                 /**< ParamCtrlBlk.config bit position for the promoted flag */
+    static constexpr uint32_t PROMOTED_MSK = 1u << PROMOTED_POS; /**< Set while served from the INTERNAL_SRAM tier */
+  }  // namespace Tier
+
+  static_assert( ( Tier::PROMOTED_MSK & ( Placement::GROUP_MSK | Placement::MANUAL_MSK ) ) == 0u,
+                 "Tier flag overlaps the placement bits" );
+
+  namespace Consistency
+  {
+    static constexpr uint32_t SEQUENCED_POS = 10u;                  /**< ParamCtrlBlk.config bit position for the sequence counter flag */
+    static constexpr uint32_t SEQUENCED_MSK = 1u << SEQUENCED_POS; /**< Cleared when the parameter has a sequence counter */
+  }  // namespace Consistency
+
+  static_assert( ( Consistency::SEQUENCED_MSK & ( Tier::PROMOTED_MSK | Placement::MANUAL_MSK ) ) == 0u,
+                 "Sequence counter flag overlaps another flag" );
+
+  namespace Stream
+  {
+    static constexpr uint32_t MAILBOX_POS  = 11u;                /**< ParamCtrlBlk.config bit position for the mailbox flag */
+    static constexpr uint32_t MAILBOX_MSK  = 1u << MAILBOX_POS; /**< Cleared when the parameter lives in a mailbox */
+    static constexpr size_t MAX_SAMPLE     = 1024;               /**< Largest mailbox sample */
+  }  // namespace Stream
+
+  static_assert( ( Stream::MAILBOX_MSK & ( Consistency::SEQUENCED_MSK | Tier::PROMOTED_MSK ) ) == 0u,
+                 "Mailbox flag overlaps another flag" );
+
+  static constexpr bool isFlash( const StorageType storage )
+  {
+    return ( storage == StorageType::INTERNAL_FLASH ) || ( storage == StorageType::EXTERNAL_FLASH0 )
+           || ( storage == StorageType::EXTERNAL_FLASH1 ) || ( storage == StorageType::EXTERNAL_FLASH2 );
+  }
+
+  static constexpr bool isExternal( const StorageType storage )
+  {
+    return ( storage == StorageType::EXTERNAL_FLASH0 ) || ( storage == StorageType::EXTERNAL_FLASH1 )
+           || ( storage == StorageType::EXTERNAL_FLASH2 ) || ( storage == StorageType::EXTERNAL_SRAM0 )
+           || ( storage == StorageType::EXTERNAL_SRAM1 ) || ( storage == StorageType::EXTERNAL_SRAM2 );
+  }
+
+  static constexpr bool isVolatile( const StorageType storage )
+  {
+    return ( storage == StorageType::INTERNAL_SRAM ) || ( storage == StorageType::EXTERNAL_SRAM0 )
+           || ( storage == StorageType::EXTERNAL_SRAM1 ) || ( storage == StorageType::EXTERNAL_SRAM2 );
+  }
+
+  static constexpr size_t alignUp( const size_t value, const size_t alignment )
+  {
+    return ( value + alignment - 1u ) & ~( alignment - 1u );
+  }
+
+  /* Bytes needed to pad a value up to the alignment, without the overflow alignUp() can hit */
+  static constexpr size_t alignPadding( const size_t value, const size_t alignment )
+  {
+    return ( 0u - value ) & ( alignment - 1u );
+  }
+
+  namespace Callback
+  {
+    static constexpr uint32_t INDEX_POS = 0u;                                  /**< ControlBlock.callback bit position of the table index */
+    static constexpr uint32_t INDEX_MSK = 0xFFFF << INDEX_POS;                 /**< Table index bit width mask */
+    static constexpr uint32_t GEN_POS   = 16u;                                 /**< ControlBlock.callback bit position of the entry generation */
+    static constexpr uint32_t GEN_MSK   = 0xFFFFu << GEN_POS;                  /**< Entry generation bit width mask */
+    static constexpr uint32_t NONE      = std::numeric_limits<uint32_t>::max(); /**< No callback attached */
+    static constexpr size_t LOCK_TIMEOUT_MS = 100;                             /**< How long to wait for the side table */
+
+    /**
+     *  Side table that owns every update callback referenced by a ControlBlock.
+     *  Entries are reference counted by the CallbackRefs pointing at them,
+     *  and each reference encodes the entry's generation so that a
+     *  block pointing at a recycled entry simply sees no callback.
+     *
+     *  Entries live in fixed chunks that are never moved or freed, so a
+     *  CallbackRef can be copied or destroyed without the lock. The lock is
+     *  only taken to hand out an entry, to recycle one whose last reference
+     *  was dropped, and to pin one from a reference that isn't owned.
+     */
+    class Registry : public Chimera::Threading::Lockable
+    {
+    public:
+      Registry() : numEntries( 0 )
+      {
+        for ( auto &chunk : chunks )
+        {
+          chunk = nullptr;
+        }
+      }
+
+      uint32_t acquire( const UpdateCallback_t &func )
+      {
+        uint32_t result = NONE;
+
+        if ( func && ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK ) )
+        {
+          uint32_t index = NONE;
+
+          if ( !freeEntries.empty() )
+          {
+            index = freeEntries.back();
+            freeEntries.pop_back();
+          }
+          else if ( numEntries < INDEX_MSK )
+          {
+            if ( !( numEntries % CHUNK_SIZE ) )
+            {
+              chunks[ numEntries / CHUNK_SIZE ].store( new Entry[ CHUNK_SIZE ], std::memory_order_release );
+            }
+
+            index = numEntries++;
+          }
+
+          if ( index != NONE )
+          {
+            Entry &entry = at( index );
+            entry.func   = func;
+            entry.references.store( 1u, std::memory_order_release );
+            result = encode( index, entry.generation );
+          }
+
+          release();
+        }
+
+        return result;
+      }
+
+      /**
+       *  Adds a reference to an entry. The caller must already own a
+       *  reference to it, so the entry can't be recycled meanwhile.
+       */
+      void retain( const uint32_t reference )
+      {
+        if ( reference != NONE )
+        {
+          at( ( reference & INDEX_MSK ) >> INDEX_POS ).references.fetch_add( 1u, std::memory_order_relaxed );
+        }
+      }
+
+      void drop( const uint32_t reference )
+      {
+        if ( reference != NONE )
+        {
+          const uint32_t index = ( reference & INDEX_MSK ) >> INDEX_POS;
+
+          if ( at( index ).references.fetch_sub( 1u, std::memory_order_acq_rel ) == 1u )
+          {
+            recycle( index );
+          }
+        }
+      }
+
+      UpdateCallback_t get( const uint32_t reference )
+      {
+        UpdateCallback_t result = nullptr;
+
+        if ( ( reference != NONE ) && ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK ) )
+        {
+          if ( Entry *entry = lookup( reference ) )
+          {
+            result = entry->func;
+          }
+
+          release();
+        }
+
+        return result;
+      }
+
+      /**
+       *  Runs the callback behind a reference without copying it. The entry is
+       *  pinned for the duration of the call so that a concurrent drop can't
+       *  destroy or recycle the function while it executes.
+       *
+       *	@param[in]	reference       The callback reference to run
+       *	@param[in]	key             Key handed to the callback
+       *	@return bool                The callback's result, false if there was none
+       */
+      bool invoke( const uint32_t reference, const std::string_view &key )
+      {
+        bool result  = false;
+        Entry *entry = nullptr;
+
+        if ( ( reference != NONE ) && ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK ) )
+        {
+          /*------------------------------------------------
+          The reference isn't owned, so its last owner may be dropping it
+          right now. Only pin an entry that still has a reference, as one at
+          zero is waiting on the lock to be recycled.
+          ------------------------------------------------*/
+          entry          = lookup( reference );
+          uint32_t count = entry ? entry->references.load( std::memory_order_relaxed ) : 0u;
+
+          while ( count && !entry->references.compare_exchange_weak( count, count + 1u, std::memory_order_acquire ) )
+          {
+          }
+
+          if ( !count )
+          {
+            entry = nullptr;
+          }
+
+          release();
+        }
+
+        if ( entry )
+        {
+          result = entry->func && entry->func( key );
+          drop( reference );
+        }
+
+        return result;
+      }
+
+    private:
+      static constexpr uint32_t CHUNK_SIZE = 64u; /**< Entries allocated at a time */
+
+      struct Entry
+      {
+        UpdateCallback_t func = nullptr;
+        uint16_t generation   = 0u; /**< Only changed under the lock */
+        std::atomic<uint32_t> references{ 0u };
+      };
+
+      std::array<std::atomic<Entry *>, ( INDEX_MSK + CHUNK_SIZE ) / CHUNK_SIZE> chunks;
+      uint32_t numEntries;
+      std::vector<uint32_t> freeEntries;
+
+      static uint32_t encode( const uint32_t index, const uint16_t generation )
+      {
+        return ( ( index << INDEX_POS ) & INDEX_MSK ) | ( ( static_cast<uint32_t>( generation ) << GEN_POS ) & GEN_MSK );
+      }
+
+      Entry &at( const uint32_t index ) const
+      {
+        return chunks[ index / CHUNK_SIZE ].load( std::memory_order_acquire )[ index % CHUNK_SIZE ];
+      }
+
+      /**
+       *  Frees an entry whose last reference was just dropped. Blocks until
+       *  the table is available, since giving up would leak the entry.
+       */
+      void recycle( const uint32_t index )
+      {
+        while ( reserve( LOCK_TIMEOUT_MS ) != Chimera::CommonStatusCodes::OK )
+        {
+        }
+
+        Entry &entry = at( index );
+        entry.func   = nullptr;
+        entry.generation++;
+        freeEntries.push_back( index );
+
+        release();
+      }
+
+      Entry *lookup( const uint32_t reference )
+      {
+        uint32_t index = ( reference & INDEX_MSK ) >> INDEX_POS;
+        Entry *result  = nullptr;
+
+        if ( ( index < numEntries ) && ( encode( index, at( index ).generation ) == reference )
+             && at( index ).references.load( std::memory_order_relaxed ) )
+        {
+          result = &at( index );
+        }
+
+        return result;
+      }
+    };
+
+    /*------------------------------------------------
+    Constructed on first use so factories in other translation
+    units can safely be created during static initialization.
+    ------------------------------------------------*/
+    static Registry &registry()
+    {
+      /* Never destroyed, as blocks held by static Managers drop their references on exit */
+      static Registry *instance = new Registry();
+      return *instance;
+    }
+  }  // namespace Callback
+
+
+  CallbackRef::CallbackRef( const CallbackRef &other ) : reference( other.reference )
+  {
+    Callback::registry().retain( reference );
+  }
+
+  CallbackRef::CallbackRef( CallbackRef &&other ) noexcept : reference( other.reference )
+  {
+    other.reference = Callback::NONE;
+  }
+
+  CallbackRef &CallbackRef::operator=( const CallbackRef &other )
+  {
+    /*------------------------------------------------
+    Take the new reference before dropping the old one in case
+    they refer to the same side table entry
+    ------------------------------------------------*/
+    Callback::registry().retain( other.reference );
+    Callback::registry().drop( reference );
+    reference = other.reference;
+
+    return *this;
+  }
+
+  CallbackRef &CallbackRef::operator=( CallbackRef &&other ) noexcept
+  {
+    std::swap( reference, other.reference );
+    return *this;
+  }
+
+  CallbackRef::~CallbackRef()
+  {
+    Callback::registry().drop( reference );
+  }
+
+
+  Manager::Manager( const size_t lockTimeout_mS ) :
+      initialized( false ), frozen( false ), transactionOpen( false ), commitSequence( 0 ), lockTimeout_mS( lockTimeout_mS ),
+      publishedIndex( nullptr ), readerEpoch( 0 ), tierEpoch( 0 ), boundDrivers( 0 )
+  {
+    readerCounts[ 0 ] = 0u;
+    readerCounts[ 1 ] = 0u;
+
+#if defined( AERO_KERNEL_PARAMETER_ASYNC_THREADS )
+    asyncPending.fill( false );
+    asyncRunning = false;
+#endif
+  }
+
+  Manager::~Manager()
+  {
+    disableAsync();
+    delete publishedIndex.exchange( nullptr );
+  }
+
+  bool Manager::init( const size_t numParameters )
+  {
+    /*------------------------------------------------
+    Slot indices must fit within a Handle
+    ------------------------------------------------*/
+    if ( numParameters >= INVALID_SLOT )
+    {
+      return false;
+    }
+
+    disableAsync();
+
+    /*------------------------------------------------
+    Don't lose cached writes to the old configuration
+    ------------------------------------------------*/
+    flush();
+    cache.init( CacheConfig(), 0 );
+
+    frozen = false;
+    frozenIndex.clear();
+
+    /*------------------------------------------------
+    Lookups may not run concurrently with init(), so nothing still
+    references the old index copies
+    ------------------------------------------------*/
+    delete publishedIndex.exchange( nullptr );
+    retiredIndexes.clear();
+    indexBase.reset();
+    indexRecent.clear();
+
+    transactionOpen = false;
+    stagedWrites.clear();
+    stagedData.clear();
+
+    tiering = TieringConfig();
+    tiers.clear();
+    tierRetired.clear();
+    accessCounts.reset();
+
+    params.init( numParameters );
+
+    controlBlocks.assign( numParameters, ControlBlock() );
+    generations.assign( numParameters, 0u );
+    mailboxes.clear();
+    mailboxes.resize( numParameters );
+    retiredMailboxes.clear();
+    sequences.reset( new std::atomic<uint32_t>[ std::max<size_t>( numParameters, 1u ) ] );
+    slotStripes.reset( new std::atomic<uint8_t>[ std::max<size_t>( numParameters, 1u ) ] );
+
+    for ( size_t x = 0; x < numParameters; x++ )
+    {
+      sequences[ x ]   = 0u;
+      slotStripes[ x ] = 0u;
+    }
+    slotKeys.assign( numParameters, Key() );
+    keyNames.init( std::max<size_t>( numParameters, 1u ) * KeyArena::AVERAGE_KEY_LENGTH );
+    keyTree.init( numParameters );
+
+    batchEntries.clear();
+    batchEntries.reserve( numParameters );
+    batchBuffer.resize( BATCH_BUFFER_SIZE );
+
+    /*------------------------------------------------
+    Fill the free list so that slots are handed out in ascending order
+    ------------------------------------------------*/
+    freeSlots.resize( numParameters );
+    for ( size_t x = 0; x < numParameters; x++ )
+    {
+      freeSlots[ x ] = static_cast<uint16_t>( numParameters - 1u - x );
+    }
+
+    memoryDriver.fill( nullptr );
+    boundDrivers = 0;
+    directBase.fill( nullptr );
+
+    for ( auto &allocator : allocators )
+    {
+      allocator.reset();
+    }
+
+    for ( auto &log : logStores )
+    {
+      log.reset();
+    }
+
+    initialized = true;
+
+    return true;
+  }
+
+  Handle Manager::registerParameter( const std::string_view &key, const ControlBlock &controlBlock )
+  {
+    return registerParameter( Key( key ), controlBlock );
+  }
+
+  Handle Manager::registerParameter( const Key &key, const ControlBlock &controlBlock )
+  {
+    Handle result;
+
+    /*------------------------------------------------
+    If the key does not exist in the map, it will be assigned a free
+    slot. Otherwise the existing slot will be accessed and updated.
+    A frozen registry cannot be modified.
+    ------------------------------------------------*/
+    if ( initialized && lockExclusive() )
+    {
+      uint16_t slot      = INVALID_SLOT;
+      ControlBlock block = controlBlock;
+
+      if ( !frozen )
+      {
+        slot = findSlot( key );
+
+        const bool exists = ( slot != INVALID_SLOT );
+
+        /*------------------------------------------------
+        A new control block starts out at home
+        ------------------------------------------------*/
+        block.config &= ~Tier::PROMOTED_MSK;
+
+        if ( ControlBlockInterpreter::isMailbox( block ) )
+        {
+          block.config &= ~static_cast<uint32_t>( Location::MEM_LOC_MSK );
+        }
+
+        if ( exists && ( controlBlocks[ slot ].config & Tier::PROMOTED_MSK ) )
+        {
+          tierEpoch++;
+          demoteSlot( slot );
+          tierEpoch++;
+        }
+
+        /*------------------------------------------------
+        Settle the address before claiming a slot so a full region
+        leaves the registry untouched
+        ------------------------------------------------*/
+        const bool sampleFits = !ControlBlockInterpreter::isMailbox( block ) || ( block.size && ( block.size <= Stream::MAX_SAMPLE ) );
+
+        if ( !sampleFits
+             || ( ( exists || !freeSlots.empty() ) && !placeParameter( exists ? controlBlocks[ slot ] : ControlBlock(), block ) ) )
+        {
+          slot = INVALID_SLOT;
+        }
+        else if ( !exists && !freeSlots.empty() )
+        {
+          slot = freeSlots.back();
+          freeSlots.pop_back();
+
+          slotKeys[ slot ] = keyNames.intern( key );
+          params.insert( slotKeys[ slot ], slot );
+          keyTree.insert( slotKeys[ slot ].view(), slot );
+          publishChange( slotKeys[ slot ], slot );
+
+          if ( accessCounts )
+          {
+            accessCounts[ slot * 2u ]        = 0u;
+            accessCounts[ ( slot * 2u ) + 1u ] = 0u;
+            tiers[ slot ]                    = TierState();
+          }
+        }
+      }
+
+      if ( slot != INVALID_SLOT )
+      {
+        if ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK )
+        {
+          evictSlot( slot );
+          cache.release();
+        }
+
+        controlBlocks[ slot ] = block;
+        result                = Handle( slot, generations[ slot ] );
+        slotStripes[ slot ]   = static_cast<uint8_t>( key.getHash() % INDEX_STRIPES );
+        attachMailbox( slot );
+      }
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  bool Manager::unregisterParameter( const std::string_view &key )
+  {
+    return unregisterParameter( Key( key ) );
+  }
+
+  bool Manager::unregisterParameter( const Key &key )
+  {
+    bool result = false;
+
+    if ( initialized && lockExclusive() )
+    {
+      uint16_t slot = frozen ? INVALID_SLOT : params.erase( key );
+
+      if ( slot != INVALID_SLOT )
+      {
+        /*------------------------------------------------
+        Bumping the generation invalidates any outstanding handles
+        ------------------------------------------------*/
+        if ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK )
+        {
+          evictSlot( slot );
+          cache.release();
+        }
+
+        accountPlacement( controlBlocks[ slot ], false );
+
+        if ( controlBlocks[ slot ].config & Tier::PROMOTED_MSK )
+        {
+          accountPlacement( tiers[ slot ].home, false );
+        }
+
+        keyTree.erase( slotKeys[ slot ].view() );
+        generations[ slot ]++;
+        publishChange( slotKeys[ slot ], INVALID_SLOT );
+        controlBlocks[ slot ] = ControlBlock();
+        slotKeys[ slot ]      = Key();
+        freeSlots.push_back( slot );
+        result = true;
+      }
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  bool Manager::isRegistered( const std::string_view &key )
+  {
+    return isRegistered( Key( key ) );
+  }
+
+  bool Manager::isRegistered( const Key &key )
+  {
+    return static_cast<bool>( getHandle( key ) );
+  }
+
+  Handle Manager::getHandle( const std::string_view &key )
+  {
+    return getHandle( Key( key ) );
+  }
+
+  Handle Manager::getHandle( const Key &key )
+  {
+    Handle result;
+    RegistryLock lock;
+
+    /*------------------------------------------------
+    A frozen registry is already lock free through its perfect hash. The
+    lock is only needed before anything has been published, or while an
+    image is being loaded.
+    ------------------------------------------------*/
+    if ( initialized && ( frozen.load( std::memory_order_acquire ) || !findPublished( key, result ) )
+         && lockRegistry( key, lock ) )
+    {
+      uint16_t slot = findSlot( key );
+
+      if ( slot != INVALID_SLOT )
+      {
+        result = Handle( slot, generations[ slot ] );
+      }
+
+      unlockRegistry( lock );
+    }
+
+    return result;
+  }
+
+  Key Manager::getKey( const Handle handle )
+  {
+    Key result;
+    RegistryLock lock;
+
+    if ( initialized && lockRegistry( handle, lock ) )
+    {
+      if ( isActive( handle ) )
+      {
+        result = slotKeys[ handle.slot ];
+      }
+
+      unlockRegistry( lock );
+    }
+
+    return result;
+  }
+
+  bool Manager::read( const std::string_view &key, void *const param )
+  {
+    return read( Key( key ), param );
+  }
+
+  bool Manager::read( const Key &key, void *const param )
+  {
+    bool result = false;
+    RegistryLock lock;
+
+    if ( initialized && param && lockRegistry( key, lock ) )
+    {
+      result = readSlot( findSlot( key ), param, 0, lock );
+    }
+
+    return result;
+  }
+
+  bool Manager::read( const Handle handle, void *const param )
+  {
+    bool result = false;
+    RegistryLock lock;
+
+    if ( initialized && param && lockRegistry( handle, lock ) )
+    {
+      result = readSlot( isActive( handle ) ? handle.slot : INVALID_SLOT, param, 0, lock );
+    }
+
+    return result;
+  }
+
+  bool Manager::write( const std::string_view &key, const void *const param )
+  {
+    return write( Key( key ), param );
+  }
+
+  bool Manager::write( const Key &key, const void *const param )
+  {
+    bool result = false;
+    RegistryLock lock;
+
+    if ( initialized && param && lockRegistry( key, lock ) )
+    {
+      result = writeSlot( findSlot( key ), param, 0, lock );
+    }
+
+    return result;
+  }
+
+  bool Manager::write( const Handle handle, const void *const param )
+  {
+    bool result = false;
+    RegistryLock lock;
+
+    if ( initialized && param && lockRegistry( handle, lock ) )
+    {
+      result = writeSlot( isActive( handle ) ? handle.slot : INVALID_SLOT, param, 0, lock );
+    }
+
+    return result;
+  }
+
+  bool Manager::readMany( const Key *const keys, void *const *const params, const size_t count )
+  {
+    bool result = false;
+
+    if ( initialized && keys && params && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      bool queued = true;
+      batchEntries.clear();
+
+      for ( size_t x = 0; x < count; x++ )
+      {
+        const uint16_t slot = findSlot( keys[ x ] );
+        countAccess( slot, false );
+        queued &= ( params[ x ] != nullptr ) && ( transferMailbox( slot, params[ x ], nullptr ) || queueBatch( slot, x ) );
+      }
+
+      result = executeBatch( params, nullptr ) && queued;
+      release();
+    }
+
+    return result;
+  }
+
+  bool Manager::readMany( const Handle *const handles, void *const *const params, const size_t count )
+  {
+    bool result = false;
+
+    if ( initialized && handles && params && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      bool queued = true;
+      batchEntries.clear();
+
+      for ( size_t x = 0; x < count; x++ )
+      {
+        const uint16_t slot = isActive( handles[ x ] ) ? handles[ x ].slot : INVALID_SLOT;
+        countAccess( slot, false );
+        queued &= ( params[ x ] != nullptr ) && ( transferMailbox( slot, params[ x ], nullptr ) || queueBatch( slot, x ) );
+      }
+
+      result = executeBatch( params, nullptr ) && queued;
+      release();
+    }
+
+    return result;
+  }
+
+  bool Manager::writeMany( const Key *const keys, const void *const *const params, const size_t count )
+  {
+    bool result = false;
+
+    if ( initialized && keys && params && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      bool queued = true;
+      batchEntries.clear();
+
+      for ( size_t x = 0; x < count; x++ )
+      {
+        const uint16_t slot = findSlot( keys[ x ] );
+        countAccess( slot, true );
+        queued &= ( params[ x ] != nullptr ) && ( transferMailbox( slot, nullptr, params[ x ] ) || queueBatch( slot, x ) );
+      }
+
+      result = executeBatch( nullptr, params ) && queued;
+      release();
+    }
+
+    return result;
+  }
+
+  bool Manager::writeMany( const Handle *const handles, const void *const *const params, const size_t count )
+  {
+    bool result = false;
+
+    if ( initialized && handles && params && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      bool queued = true;
+      batchEntries.clear();
+
+      for ( size_t x = 0; x < count; x++ )
+      {
+        const uint16_t slot = isActive( handles[ x ] ) ? handles[ x ].slot : INVALID_SLOT;
+        countAccess( slot, true );
+        queued &= ( params[ x ] != nullptr ) && ( transferMailbox( slot, nullptr, params[ x ] ) || queueBatch( slot, x ) );
+      }
+
+      result = executeBatch( nullptr, params ) && queued;
+      release();
+    }
+
+    return result;
+  }
+
+  bool Manager::enableAsync( const size_t queueDepth )
+  {
+    bool result = initialized && queueDepth;
+
+    if ( result )
+    {
+      disableAsync();
+
+      for ( auto &queue : asyncQueues )
+      {
+        result &= queue.init( queueDepth, lockTimeout_mS );
+      }
+
+#if defined( AERO_KERNEL_PARAMETER_ASYNC_THREADS )
+      /*------------------------------------------------
+      One worker per storage device. A worker sleeps until queueAsync() flags
+      its queue as pending, then drains everything queued. The flag is only
+      touched under asyncMutex, so a request queued while the worker drains
+      keeps it awake for another pass instead of being missed.
+      ------------------------------------------------*/
+      {
+        std::lock_guard<std::mutex> lock( asyncMutex );
+        asyncPending.fill( false );
+        asyncRunning = true;
+      }
+
+      for ( size_t x = 0; x < asyncWorkers.size(); x++ )
+      {
+        asyncWorkers[ x ] = std::thread( [ this, x ]() {
+          while ( asyncRunning )
+          {
+            {
+              std::unique_lock<std::mutex> lock( asyncMutex );
+              asyncSignal.wait( lock, [ this, x ]() { return asyncPending[ x ] || !asyncRunning; } );
+              asyncPending[ x ] = false;
+            }
+
+            while ( serviceAsync( static_cast<StorageType>( x ) ) )
+            {
+            }
+          }
+        } );
+      }
+#endif
+    }
+
+    return result;
+  }
+
+  void Manager::disableAsync()
+  {
+    /*------------------------------------------------
+    Close the queues first so nothing can be queued behind the drain below
+    and then be dropped without its callback
+    ------------------------------------------------*/
+    for ( auto &queue : asyncQueues )
+    {
+      queue.close( lockTimeout_mS );
+    }
+
+#if defined( AERO_KERNEL_PARAMETER_ASYNC_THREADS )
+    {
+      std::lock_guard<std::mutex> lock( asyncMutex );
+      asyncRunning = false;
+      asyncSignal.notify_all();
+    }
+
+    for ( auto &worker : asyncWorkers )
+    {
+      if ( worker.joinable() )
+      {
+        worker.join();
+      }
+    }
+#endif
+
+    /*------------------------------------------------
+    Nobody is left to service what remains, so fail it
+    ------------------------------------------------*/
+    for ( auto &queue : asyncQueues )
+    {
+      AsyncRequest request;
+
+      while ( queue.pop( request, lockTimeout_mS ) )
+      {
+        if ( request.callback )
+        {
+          request.callback( request.handle, false );
+        }
+      }
+
+      queue.init( 0, lockTimeout_mS );
+    }
+  }
+
+  bool Manager::readAsync( const Handle handle, void *const param, AsyncCallback_t callback )
+  {
+    AsyncRequest request;
+    request.handle     = handle;
+    request.readBuffer = param;
+    request.callback   = std::move( callback );
+
+    return param && queueAsync( std::move( request ) );
+  }
+
+  bool Manager::readAsync( const Key &key, void *const param, AsyncCallback_t callback )
+  {
+    return readAsync( getHandle( key ), param, std::move( callback ) );
+  }
+
+  bool Manager::writeAsync( const Handle handle, const void *const param, AsyncCallback_t callback )
+  {
+    AsyncRequest request;
+    request.handle      = handle;
+    request.writeBuffer = param;
+    request.callback    = std::move( callback );
+
+    return param && queueAsync( std::move( request ) );
+  }
+
+  bool Manager::writeAsync( const Key &key, const void *const param, AsyncCallback_t callback )
+  {
+    return writeAsync( getHandle( key ), param, std::move( callback ) );
+  }
+
+#if defined( AERO_KERNEL_PARAMETER_ASYNC_THREADS )
+  std::future<bool> Manager::readAsync( const Handle handle, void *const param )
+  {
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto result  = promise->get_future();
+
+    if ( !readAsync( handle, param, [ promise ]( const Handle, const bool success ) { promise->set_value( success ); } ) )
+    {
+      promise->set_value( false );
+    }
+
+    return result;
+  }
+
+  std::future<bool> Manager::writeAsync( const Handle handle, const void *const param )
+  {
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto result  = promise->get_future();
+
+    if ( !writeAsync( handle, param, [ promise ]( const Handle, const bool success ) { promise->set_value( success ); } ) )
+    {
+      promise->set_value( false );
+    }
+
+    return result;
+  }
+#endif
+
+  size_t Manager::serviceAsync( const StorageType storage, const size_t maxRequests )
+  {
+    size_t result = 0;
+
+    if ( storage != StorageType::NONE )
+    {
+      AsyncQueue<AsyncRequest> &queue = asyncQueues[ static_cast<uint8_t>( storage ) ];
+      AsyncRequest request;
+
+      while ( ( result < maxRequests ) && queue.pop( request, lockTimeout_mS ) )
+      {
+        bool success = false;
+
+        if ( request.readBuffer )
+        {
+          success = read( request.handle, request.readBuffer );
+        }
+        else
+        {
+          success = write( request.handle, request.writeBuffer );
+        }
+
+        if ( request.callback )
+        {
+          request.callback( request.handle, success );
+        }
+
+        result++;
+      }
+    }
+
+    return result;
+  }
+
+  bool Manager::update( const std::string_view &key )
+  {
+    return update( Key( key ) );
+  }
+
+  bool Manager::update( const Key &key )
+  {
+    bool result = false;
+    RegistryLock lock;
+
+    if ( initialized && lockRegistry( key, lock ) )
+    {
+      /*------------------------------------------------
+      Invoke the callback in place rather than copying it out, as copying
+      a std::function is allowed to allocate. The side table pins the entry
+      while it runs, so only the reference is needed past the lock.
+      ------------------------------------------------*/
+      uint32_t reference = Callback::NONE;
+      uint16_t slot      = findSlot( key );
+
+      if ( slot != INVALID_SLOT )
+      {
+        reference = controlBlocks[ slot ].callback.get();
+      }
+
+      unlockRegistry( lock );
+
+      result = Callback::registry().invoke( reference, key.view() );
+    }
+
+    return result;
+  }
+
+  bool Manager::registerMemoryDriver( const StorageType storage, Chimera::Modules::Memory::Device_sPtr &driver )
+  {
+    bool result = false;
+
+    if ( initialized && ( storage != StorageType::NONE ) && lockExclusive() )
+    {
+      if ( !frozen && !( boundDrivers & ( 1u << static_cast<uint8_t>( storage ) ) ) )
+      {
+        memoryDriver[ static_cast<uint8_t>(storage) ] = driver;
+        result = true;
+      }
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  bool Manager::bindMemoryDriver( const StorageType storage, Chimera::Modules::Memory::Device_sPtr &driver )
+  {
+    bool result = false;
+
+    if ( registerMemoryDriver( storage, driver ) && lockExclusive() )
+    {
+      boundDrivers |= static_cast<uint16_t>( 1u << static_cast<uint8_t>( storage ) );
+      result = true;
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  bool Manager::registerMemorySpecs( const StorageType storage, const Chimera::Modules::Memory::Descriptor &specs )
+  {
+    bool result = false;
+
+    if ( initialized && ( storage != StorageType::NONE ) && lockExclusive() )
+    {
+      if ( !frozen )
+      {
+        memorySpecs[ static_cast<uint8_t>( storage ) ] = specs;
+        allocators[ static_cast<uint8_t>( storage ) ].init( specs );
+        result = true;
+
+        /*------------------------------------------------
+        The new allocator starts out empty, so hand it every placement it
+        would otherwise give out again: registered parameters, the homes
+        of promoted ones and promoted copies not yet reclaimed
+        ------------------------------------------------*/
+        auto reclaim = [ this, storage ]( const ControlBlock &block ) {
+          if ( ControlBlockInterpreter::getStorage( block ) == storage )
+          {
+            accountPlacement( block, true );
+          }
+        };
+
+        params.forEach( [ this, &reclaim ]( const Key &, const uint16_t slot ) {
+          reclaim( controlBlocks[ slot ] );
+
+          if ( controlBlocks[ slot ].config & Tier::PROMOTED_MSK )
+          {
+            reclaim( tiers[ slot ].home );
+          }
+        } );
+
+        for ( const auto &block : tierRetired )
+        {
+          reclaim( block );
+        }
+      }
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  bool Manager::registerDirectAccess( const StorageType storage, void *const baseAddress )
+  {
+    bool result = false;
+
+    if ( initialized && ( storage != StorageType::NONE ) && lockExclusive() )
+    {
+      if ( !frozen )
+      {
+        directBase[ static_cast<uint8_t>( storage ) ] = reinterpret_cast<uint8_t *>( baseAddress );
+        result = true;
+      }
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  bool Manager::enableLogStore( const StorageType storage )
+  {
+    bool result = false;
+
+    if ( initialized && ( storage != StorageType::NONE ) && lockExclusive() )
+    {
+      const uint8_t index = static_cast<uint8_t>( storage );
+
+      if ( !frozen && memoryDriver[ index ] )
+      {
+        auto log = std::make_shared<LogStore>();
+
+        if ( log->mount( memoryDriver[ index ], memorySpecs[ index ] ) )
+        {
+          logStores[ index ] = std::move( log );
+          result             = true;
+        }
+
+        /*------------------------------------------------
+        Cached lines address the device directly, which no longer means
+        anything now that the region holds a log
+        ------------------------------------------------*/
+        if ( result && ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+        {
+          for ( size_t x = 0; x < cache.lineCount(); x++ )
+          {
+            if ( ( cache.line( x ).slot != Cache::NO_LINE ) && ( cache.line( x ).storage == index ) )
+            {
+              cache.invalidate( cache.line( x ) );
+            }
+          }
+
+          cache.release();
+        }
+      }
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  bool Manager::collectGarbage( const StorageType storage )
+  {
+    bool result = false;
+
+    if ( initialized && ( storage != StorageType::NONE ) )
+    {
+      std::shared_ptr<LogStore> log;
+
+      if ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK )
+      {
+        log = logStores[ static_cast<uint8_t>( storage ) ];
+        release();
+      }
+
+      result = log && log->collect();
+    }
+
+    return result;
+  }
+
+  bool Manager::enableCache( const CacheConfig &config )
+  {
+    bool result = false;
+
+    if ( initialized && lockExclusive() )
+    {
+      if ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK )
+      {
+        result = writeBackDirty() && cache.init( config, controlBlocks.size() );
+
+        if ( result )
+        {
+          persistOrder.clear();
+          persistOrder.reserve( config.lines );
+          persistBuffer.resize( config.lines ? BATCH_BUFFER_SIZE : 0u );
+        }
+
+        cache.release();
+      }
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  bool Manager::flush()
+  {
+    return persistDirty();
+  }
+
+  bool Manager::persistDirty()
+  {
+    bool result = true;
+
+    if ( cache.isEnabled() )
+    {
+      result = ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK );
+
+      if ( result )
+      {
+        result = writeBackDirty();
+        cache.release();
+      }
+    }
+
+    return result;
+  }
+
+  bool Manager::isDirty( const Handle handle )
+  {
+    bool result = false;
+    RegistryLock lock;
+
+    if ( initialized && lockRegistry( handle, lock ) )
+    {
+      const uint16_t slot = isActive( handle ) ? handle.slot : INVALID_SLOT;
+      unlockRegistry( lock );
+
+      if ( cache.isEnabled() && ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+      {
+        result = cache.isDirty( slot );
+        cache.release();
+      }
+    }
+
+    return result;
+  }
+
+  bool Manager::enableTiering( const TieringConfig &config )
+  {
+    bool result = false;
+
+    if ( initialized && lockExclusive() )
+    {
+      if ( !frozen )
+      {
+        /*------------------------------------------------
+        Send everything home before the policy changes, which leaves
+        nothing in the tier if tiering is being turned off
+        ------------------------------------------------*/
+        bool demoted = true;
+
+        tierEpoch++;
+
+        params.forEach( [ this, &demoted ]( const Key &, const uint16_t slot ) {
+          if ( controlBlocks[ slot ].config & Tier::PROMOTED_MSK )
+          {
+            demoted &= demoteSlot( slot );
+          }
+        } );
+
+        tierEpoch++;
+
+        if ( demoted )
+        {
+          tiering = config;
+
+          if ( !config.maxPromoted )
+          {
+            tiers.clear();
+            accessCounts.reset();
+          }
+          else if ( !accessCounts )
+          {
+            tiers.assign( controlBlocks.size(), TierState() );
+            accessCounts.reset( new std::atomic<uint32_t>[ controlBlocks.size() * 2u ] );
+
+            for ( size_t x = 0; x < ( controlBlocks.size() * 2u ); x++ )
+            {
+              accessCounts[ x ] = 0u;
+            }
+          }
+
+          result = true;
+        }
+      }
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  size_t Manager::rebalanceTiers()
+  {
+    size_t result = 0;
+
+    if ( initialized && lockExclusive() )
+    {
+      if ( !frozen && accessCounts )
+      {
+        /*------------------------------------------------
+        Space given up by the last round is only reused now, so an access
+        that raced with a demotion never sees another parameter's data
+        ------------------------------------------------*/
+        for ( const auto &block : tierRetired )
+        {
+          accountPlacement( block, false );
+        }
+
+        tierRetired.clear();
+
+        /*------------------------------------------------
+        Age every parameter, sending cold ones home
+        ------------------------------------------------*/
+        std::vector<uint16_t> candidates;
+        size_t promoted = 0;
+
+        tierEpoch++;
+
+        params.forEach( [ this, &candidates, &promoted, &result ]( const Key &, const uint16_t slot ) {
+          TierState &tier      = tiers[ slot ];
+          const uint32_t total = accessCounts[ slot * 2u ].load( std::memory_order_relaxed )
+                                 + accessCounts[ ( slot * 2u ) + 1u ].load( std::memory_order_relaxed );
+
+          tier.heat = ( tier.heat / 2u ) + ( total - tier.seen );
+          tier.seen = total;
+
+          if ( !( controlBlocks[ slot ].config & Tier::PROMOTED_MSK ) )
+          {
+            if ( ( tier.heat >= tiering.promoteThreshold ) && isExternal( ControlBlockInterpreter::getStorage( controlBlocks[ slot ] ) ) )
+            {
+              candidates.push_back( slot );
+            }
+          }
+          else if ( ( tier.heat < tiering.demoteThreshold ) && demoteSlot( slot ) )
+          {
+            result++;
+          }
+          else
+          {
+            promoted++;
+          }
+        } );
+
+        /*------------------------------------------------
+        Promote the hottest first while the tier has room
+        ------------------------------------------------*/
+        std::sort( candidates.begin(), candidates.end(),
+                   [ this ]( const uint16_t a, const uint16_t b ) { return tiers[ a ].heat > tiers[ b ].heat; } );
+
+        for ( size_t x = 0; ( x < candidates.size() ) && ( promoted < tiering.maxPromoted ); x++ )
+        {
+          if ( promoteSlot( candidates[ x ] ) )
+          {
+            promoted++;
+            result++;
+          }
+        }
+
+        tierEpoch++;
+      }
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  bool Manager::getAccessStats( const Handle handle, AccessStats &stats )
+  {
+    bool result = false;
+
+    if ( initialized && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      if ( accessCounts && isActive( handle ) )
+      {
+        const uint16_t slot = handle.slot;
+
+        stats.reads    = accessCounts[ slot * 2u ].load( std::memory_order_relaxed );
+        stats.writes   = accessCounts[ ( slot * 2u ) + 1u ].load( std::memory_order_relaxed );
+        stats.heat     = tiers[ slot ].heat;
+        stats.storage  = ControlBlockInterpreter::getStorage( controlBlocks[ slot ] );
+        stats.home     = ControlBlockInterpreter::getStorage( homeBlock( slot ) );
+        stats.promoted = ( controlBlocks[ slot ].config & Tier::PROMOTED_MSK );
+        result         = true;
+      }
+
+      release();
+    }
+
+    return result;
+  }
+
+  View Manager::view( const std::string_view &key )
+  {
+    return view( Key( key ) );
+  }
+
+  View Manager::view( const Key &key )
+  {
+    View result;
+    RegistryLock lock;
+
+    if ( initialized && lockRegistry( key, lock ) )
+    {
+      result = viewSlot( findSlot( key ), lock );
+    }
+
+    return result;
+  }
+
+  View Manager::view( const Handle handle )
+  {
+    View result;
+    RegistryLock lock;
+
+    if ( initialized && lockRegistry( handle, lock ) )
+    {
+      result = viewSlot( isActive( handle ) ? handle.slot : INVALID_SLOT, lock );
+    }
+
+    return result;
+  }
+
+  Mailbox *Manager::mailbox( const std::string_view &key )
+  {
+    return mailbox( Key( key ) );
+  }
+
+  Mailbox *Manager::mailbox( const Key &key )
+  {
+    Mailbox *result = nullptr;
+    RegistryLock lock;
+
+    if ( initialized && lockRegistry( key, lock ) )
+    {
+      result = slotMailbox( findSlot( key ) );
+      unlockRegistry( lock );
+    }
+
+    return result;
+  }
+
+  Mailbox *Manager::mailbox( const Handle handle )
+  {
+    Mailbox *result = nullptr;
+    RegistryLock lock;
+
+    if ( initialized && lockRegistry( handle, lock ) )
+    {
+      result = slotMailbox( activeSlot( handle ) );
+      unlockRegistry( lock );
+    }
+
+    return result;
+  }
+
+  const AeroKernel::Parameter::ControlBlock &Manager::getControlBlock( const std::string_view &key )
+  {
+    return getControlBlock( Key( key ) );
+  }
+
+  const AeroKernel::Parameter::ControlBlock &Manager::getControlBlock( const Key &key )
+  {
+    static const ControlBlock invalid;
+
+    uint16_t slot = findSlot( key );
+    return ( slot != INVALID_SLOT ) ? controlBlocks[ slot ] : invalid;
+  }
+
+  bool Manager::freeze()
+  {
+    bool result = false;
+
+    if ( initialized && lockExclusive() )
+    {
+      if ( frozen )
+      {
+        result = true;
+      }
+      else
+      {
+        std::vector<std::pair<Key, uint16_t>> entries;
+        entries.reserve( params.size() );
+        params.forEach( [ &entries ]( const Key &key, const uint16_t slot ) { entries.emplace_back( key, slot ); } );
+
+        if ( frozenIndex.build( entries ) )
+        {
+          frozen.store( true, std::memory_order_release );
+          result = true;
+        }
+      }
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  bool Manager::forEachUnder( const std::string_view &prefix, const VisitCallback_t &func )
+  {
+    bool result = false;
+    RegistryLock lock;
+    std::vector<std::pair<Key, Handle>> visits;
+
+    if ( initialized && func && lockRegistry( Key( prefix ), lock ) )
+    {
+      keyTree.forEachUnder( prefix, [ this, &visits ]( const uint16_t slot ) {
+        visits.emplace_back( slotKeys[ slot ], Handle( slot, generations[ slot ] ) );
+      } );
+
+      unlockRegistry( lock );
+
+      for ( const auto &visit : visits )
+      {
+        func( visit.first, visit.second );
+      }
+
+      result = true;
+    }
+
+    return result;
+  }
+
+  size_t Manager::snapshot( const std::string_view &prefix, uint8_t *const buffer, const size_t size )
+  {
+    size_t result = 0;
+
+    if ( initialized && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      std::vector<uint16_t> slots;
+      keyTree.forEachUnder( prefix, [ &slots ]( const uint16_t slot ) { slots.push_back( slot ); } );
+
+      /*------------------------------------------------
+      Lay out the records and check they will fit
+      ------------------------------------------------*/
+      size_t required = 0;
+
+      for ( const uint16_t slot : slots )
+      {
+        required += sizeof( SnapshotRecord ) + alignUp( slotKeys[ slot ].view().size(), SNAPSHOT_ALIGNMENT )
+                    + alignUp( ControlBlockInterpreter::getSize( controlBlocks[ slot ] ), SNAPSHOT_ALIGNMENT );
+      }
+
+      if ( !buffer )
+      {
+        result = required;
+      }
+      else if ( required <= size )
+      {
+        /*------------------------------------------------
+        Fill in the headers and names, then read all the data as one batch
+        ------------------------------------------------*/
+        std::vector<void *> dataPtrs( slots.size() );
+        size_t offset = 0;
+        bool queued   = true;
+
+        memset( buffer, 0, required );
+        batchEntries.clear();
+
+        for ( size_t x = 0; x < slots.size(); x++ )
+        {
+          const std::string_view &name = slotKeys[ slots[ x ] ].view();
+          SnapshotRecord record;
+          record.nameLength = static_cast<uint32_t>( name.size() );
+          record.size       = static_cast<uint32_t>( ControlBlockInterpreter::getSize( controlBlocks[ slots[ x ] ] ) );
+
+          memcpy( buffer + offset, &record, sizeof( record ) );
+          offset += sizeof( record );
+
+          memcpy( buffer + offset, name.data(), name.size() );
+          offset += alignUp( name.size(), SNAPSHOT_ALIGNMENT );
+
+          dataPtrs[ x ] = buffer + offset;
+          offset += alignUp( record.size, SNAPSHOT_ALIGNMENT );
+
+          queued &= transferMailbox( slots[ x ], dataPtrs[ x ], nullptr ) || queueBatch( slots[ x ], x );
+        }
+
+        if ( queued && executeBatch( dataPtrs.data(), nullptr ) )
+        {
+          result = required;
+        }
+      }
+
+      release();
+    }
+
+    return result;
+  }
+
+  bool Manager::restore( const uint8_t *const buffer, const size_t size )
+  {
+    bool result = false;
+
+    if ( initialized && buffer && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      std::vector<const void *> dataPtrs;
+      size_t offset = 0;
+      bool queued   = true;
+
+      batchEntries.clear();
+
+      /*------------------------------------------------
+      Walk the records, matching each one up with a registered parameter
+      ------------------------------------------------*/
+      while ( ( size - offset ) >= sizeof( SnapshotRecord ) )
+      {
+        SnapshotRecord record;
+        memcpy( &record, buffer + offset, sizeof( record ) );
+        offset += sizeof( record );
+
+        /*------------------------------------------------
+        Check each field against what is left of the buffer before adding
+        it to the offset, so a corrupt length can't wrap the offset around
+        ------------------------------------------------*/
+        const size_t namePadding = alignPadding( record.nameLength, SNAPSHOT_ALIGNMENT );
+        const size_t dataPadding = alignPadding( record.size, SNAPSHOT_ALIGNMENT );
+
+        if ( ( record.nameLength > ( size - offset ) ) || ( namePadding > ( size - offset - record.nameLength ) )
+             || ( record.size > ( size - offset - record.nameLength - namePadding ) ) )
+        {
+          queued = false;
+          break;
+        }
+
+        const size_t nameOffset = offset;
+        const size_t dataOffset = nameOffset + record.nameLength + namePadding;
+        offset                  = dataOffset + record.size;
+        offset += std::min( dataPadding, size - offset );
+
+        const Key key( std::string_view( reinterpret_cast<const char *>( buffer + nameOffset ), record.nameLength ) );
+        const uint16_t slot = findSlot( key );
+
+        if ( ( slot != INVALID_SLOT ) && ( ControlBlockInterpreter::getSize( controlBlocks[ slot ] ) == record.size ) )
+        {
+          if ( !transferMailbox( slot, nullptr, buffer + dataOffset ) )
+          {
+            queued &= queueBatch( slot, dataPtrs.size() );
+            dataPtrs.push_back( buffer + dataOffset );
+          }
+        }
+        else
+        {
+          queued = false;
+        }
+      }
+
+      result = executeBatch( nullptr, dataPtrs.data() ) && queued;
+      release();
+    }
+
+    return result;
+  }
+
+  size_t Manager::saveImage( Chimera::Modules::Memory::Device_sPtr &device, const size_t address )
+  {
+    size_t result = 0;
+    std::vector<uint8_t> image;
+
+    if ( initialized && device && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      /*------------------------------------------------
+      Lay out the image. Entries are kept in slot order so that loading
+      fills the control block array front to back.
+      ------------------------------------------------*/
+      std::vector<uint16_t> slots;
+      slots.reserve( params.size() );
+      params.forEach( [ &slots ]( const Key &, const uint16_t slot ) { slots.push_back( slot ); } );
+      std::sort( slots.begin(), slots.end() );
+
+      size_t namesSize  = 0;
+      size_t valuesSize = 0;
+
+      for ( const uint16_t slot : slots )
+      {
+        namesSize += slotKeys[ slot ].view().size();
+        valuesSize += alignUp( ControlBlockInterpreter::getSize( controlBlocks[ slot ] ), IMAGE_ALIGNMENT );
+      }
+
+      namesSize = alignUp( namesSize, IMAGE_ALIGNMENT );
+
+      const size_t namesStart  = sizeof( ImageHeader ) + ( slots.size() * sizeof( ImageEntry ) );
+      const size_t valuesStart = namesStart + namesSize;
+      image.assign( valuesStart + valuesSize, 0u );
+
+      /*------------------------------------------------
+      Fill in the entries and names, then read all the values as one batch
+      ------------------------------------------------*/
+      std::vector<void *> dataPtrs( slots.size() );
+      size_t nameOffset  = 0;
+      size_t valueOffset = 0;
+
+      batchEntries.clear();
+
+      for ( size_t x = 0; x < slots.size(); x++ )
+      {
+        const uint16_t slot          = slots[ x ];
+        const std::string_view &name = slotKeys[ slot ].view();
+        const ControlBlock &block    = homeBlock( slot );
+
+        ImageEntry entry  = {};
+        entry.hash        = slotKeys[ slot ].getHash();
+        entry.nameOffset  = static_cast<uint32_t>( nameOffset );
+        entry.nameLength  = static_cast<uint16_t>( name.size() );
+        entry.slot        = slot;
+        entry.valueOffset = queueBatch( slot, x ) ? static_cast<uint32_t>( valueOffset ) : IMAGE_NO_VALUE;
+        entry.address     = block.address;
+        entry.size        = block.size;
+        entry.config      = block.config;
+        entry.reserved    = Callback::NONE;
+
+        memcpy( image.data() + sizeof( ImageHeader ) + ( x * sizeof( ImageEntry ) ), &entry, sizeof( entry ) );
+        memcpy( image.data() + namesStart + nameOffset, name.data(), name.size() );
+        dataPtrs[ x ] = image.data() + valuesStart + valueOffset;
+
+        nameOffset += name.size();
+        valueOffset += alignUp( entry.size, IMAGE_ALIGNMENT );
+      }
+
+      if ( executeBatch( dataPtrs.data(), nullptr ) )
+      {
+        ImageHeader header;
+        header.magic      = IMAGE_MAGIC;
+        header.version    = IMAGE_VERSION;
+        header.entrySize  = sizeof( ImageEntry );
+        header.entryCount = static_cast<uint32_t>( slots.size() );
+        header.namesSize  = static_cast<uint32_t>( namesSize );
+        header.valuesSize = static_cast<uint32_t>( valuesSize );
+        header.totalSize  = static_cast<uint32_t>( image.size() );
+        header.checksum   = imageChecksum( image.data(), image.size() );
+        header.reserved   = 0;
+
+        memcpy( image.data(), &header, sizeof( header ) );
+      }
+      else
+      {
+        image.clear();
+      }
+
+      release();
+    }
+
+    /*------------------------------------------------
+    Store the image outside the lock. Not every device needs or supports an
+    erase, so rather than trusting its status, read the image back to make
+    sure it was stored intact.
+    ------------------------------------------------*/
+    if ( !image.empty() )
+    {
+      device->erase( address, image.size() );
+
+      bool stored = ( device->write( address, image.data(), image.size() ) == Chimera::CommonStatusCodes::OK );
+      std::array<uint8_t, 64> check;
+
+      for ( size_t offset = 0; stored && ( offset < image.size() ); offset += check.size() )
+      {
+        const size_t chunk = std::min( check.size(), image.size() - offset );
+
+        stored = ( device->read( address + offset, check.data(), chunk ) == Chimera::CommonStatusCodes::OK )
+                 && ( memcmp( check.data(), image.data() + offset, chunk ) == 0 );
+      }
+
+      result = stored ? image.size() : 0u;
+    }
+
+    return result;
+  }
+
+  bool Manager::loadImage( Chimera::Modules::Memory::Device_sPtr &device, const size_t address, const size_t maxSize )
+  {
+    bool result     = false;
+    bool valid      = false;
+    size_t capacity = controlBlocks.size();
+    ImageHeader header = {};
+    std::vector<uint8_t> image;
+
+    /*------------------------------------------------
+    Fetch the header to learn the image size, then everything else with a
+    single read, checking it all before the registry is touched. The size is
+    bounded before anything is allocated, as the checksum can't vouch for the
+    header until the whole image has been read.
+    ------------------------------------------------*/
+    if ( initialized && device && !frozen
+         && ( device->read( address, reinterpret_cast<uint8_t *>( &header ), sizeof( header ) ) == Chimera::CommonStatusCodes::OK )
+         && ( header.magic == IMAGE_MAGIC ) && ( header.version == IMAGE_VERSION )
+         && ( header.entrySize == sizeof( ImageEntry ) ) && ( header.entryCount <= capacity )
+         && ( header.totalSize <= maxSize ) && ( header.namesSize <= header.totalSize ) && ( header.valuesSize <= header.totalSize )
+         && ( header.totalSize == ( sizeof( ImageHeader ) + ( header.entryCount * sizeof( ImageEntry ) ) + header.namesSize
+                                    + header.valuesSize ) ) )
+    {
+      image.resize( header.totalSize );
+      memcpy( image.data(), &header, sizeof( header ) );
+
+      valid = ( device->read( address + sizeof( header ), image.data() + sizeof( header ), image.size() - sizeof( header ) )
+                == Chimera::CommonStatusCodes::OK )
+              && ( imageChecksum( image.data(), image.size() ) == header.checksum );
+    }
+
+    const uint8_t *entries = nullptr;
+    const char *names      = nullptr;
+    const uint8_t *values  = nullptr;
+
+    if ( valid )
+    {
+      entries = image.data() + sizeof( ImageHeader );
+      names   = reinterpret_cast<const char *>( entries + ( header.entryCount * sizeof( ImageEntry ) ) );
+      values  = reinterpret_cast<const uint8_t *>( names ) + header.namesSize;
+    }
+
+    std::vector<bool> taken( capacity, false );
+    std::vector<std::pair<uint32_t, std::string_view>> keys;
+
+    keys.reserve( valid ? header.entryCount : 0u );
+
+    for ( size_t x = 0; valid && ( x < header.entryCount ); x++ )
+    {
+      ImageEntry entry;
+      memcpy( &entry, entries + ( x * sizeof( ImageEntry ) ), sizeof( entry ) );
+
+      valid = ( entry.slot < capacity ) && !taken[ entry.slot ]
+              && ( ( static_cast<size_t>( entry.nameOffset ) + entry.nameLength ) <= header.namesSize )
+              && ( ( entry.valueOffset == IMAGE_NO_VALUE )
+                   || ( ( static_cast<uint64_t>( entry.valueOffset ) + entry.size ) <= header.valuesSize ) );
+
+      /*------------------------------------------------
+      The index is built from the stored hashes, so each one has to match
+      its name. Hashing the names costs little next to reading the image.
+      ------------------------------------------------*/
+      if ( valid )
+      {
+        const std::string_view name( names + entry.nameOffset, entry.nameLength );
+        valid = ( Key( name ).getHash() == entry.hash );
+
+        taken[ entry.slot ] = true;
+        keys.emplace_back( entry.hash, name );
+      }
+    }
+
+    /*------------------------------------------------
+    Each name may appear only once, otherwise the index would silently keep
+    one of them. Now that the hashes are known to be right, sorting by them
+    puts any repeats next to each other.
+    ------------------------------------------------*/
+    if ( valid )
+    {
+      std::sort( keys.begin(), keys.end() );
+      valid = ( std::adjacent_find( keys.begin(), keys.end() ) == keys.end() );
+    }
+
+    if ( valid && lockExclusive() )
+    {
+      if ( !frozen && ( capacity == controlBlocks.size() ) )
+      {
+        /*------------------------------------------------
+        Retire the current registry. Bumping the generations invalidates any
+        outstanding handles. Interned names stay put, as canonical keys handed
+        out earlier may still refer to them.
+        ------------------------------------------------*/
+        std::vector<uint16_t> active;
+        active.reserve( params.size() );
+        params.forEach( [ &active ]( const Key &, const uint16_t slot ) { active.push_back( slot ); } );
+
+        if ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK )
+        {
+          for ( const uint16_t slot : active )
+          {
+            evictSlot( slot );
+          }
+
+          cache.release();
+        }
+
+        for ( const uint16_t slot : active )
+        {
+          accountPlacement( controlBlocks[ slot ], false );
+
+          if ( controlBlocks[ slot ].config & Tier::PROMOTED_MSK )
+          {
+            accountPlacement( tiers[ slot ].home, false );
+          }
+
+          generations[ slot ]++;
+        }
+
+        if ( accessCounts )
+        {
+          tiers.assign( capacity, TierState() );
+
+          for ( size_t x = 0; x < ( capacity * 2u ); x++ )
+          {
+            accessCounts[ x ] = 0u;
+          }
+        }
+
+        retireIndex();
+        params.init( capacity );
+        keyTree.init( capacity );
+        controlBlocks.assign( capacity, ControlBlock() );
+        slotKeys.assign( capacity, Key() );
+
+        /*------------------------------------------------
+        Build the index straight from the entries, reusing the hashes
+        checked above
+        ------------------------------------------------*/
+        std::vector<const void *> dataPtrs;
+        bool queued  = true;
+        bool indexed = true;
+
+        batchEntries.clear();
+
+        for ( size_t x = 0; x < header.entryCount; x++ )
+        {
+          ImageEntry entry;
+          memcpy( &entry, entries + ( x * sizeof( ImageEntry ) ), sizeof( entry ) );
+
+          const uint16_t slot = entry.slot;
+          slotKeys[ slot ]    = keyNames.intern( std::string_view( names + entry.nameOffset, entry.nameLength ), entry.hash );
+          indexed &= params.insert( slotKeys[ slot ], slot );
+          keyTree.insert( slotKeys[ slot ].view(), slot );
+
+          controlBlocks[ slot ].address = entry.address;
+          controlBlocks[ slot ].size    = entry.size;
+          controlBlocks[ slot ].config  = entry.config;
+          accountPlacement( controlBlocks[ slot ], true );
+          attachMailbox( slot );
+          slotStripes[ slot ] = static_cast<uint8_t>( entry.hash % INDEX_STRIPES );
+
+          /*------------------------------------------------
+          Only volatile memory lost its contents since the image was saved
+          ------------------------------------------------*/
+          if ( ( entry.valueOffset != IMAGE_NO_VALUE ) && isVolatile( ControlBlockInterpreter::getStorage( controlBlocks[ slot ] ) ) )
+          {
+            queued &= queueBatch( slot, dataPtrs.size() );
+            dataPtrs.push_back( values + entry.valueOffset );
+          }
+        }
+
+        /*------------------------------------------------
+        Hand out the remaining slots in ascending order, as init() does
+        ------------------------------------------------*/
+        freeSlots.clear();
+
+        for ( size_t x = capacity; x > 0; x-- )
+        {
+          if ( !taken[ x - 1u ] )
+          {
+            freeSlots.push_back( static_cast<uint16_t>( x - 1u ) );
+          }
+        }
+
+        publishIndex();
+        result = executeBatch( nullptr, dataPtrs.data() ) && queued && indexed;
+      }
+
+      unlockExclusive();
+    }
+
+    return result;
+  }
+
+  uint32_t Manager::imageChecksum( const uint8_t *const image, const size_t size )
+  {
+    return Key::hashOf(
+        std::string_view( reinterpret_cast<const char *>( image ) + sizeof( ImageHeader ), size - sizeof( ImageHeader ) ) );
+  }
+
+  bool Manager::isFrozen() const
+  {
+    return frozen.load( std::memory_order_acquire );
+  }
+
+  bool Manager::beginTransaction()
+  {
+    bool result = false;
+
+    if ( initialized && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      if ( !transactionOpen )
+      {
+        stagedWrites.clear();
+        stagedData.clear();
+        transactionOpen.store( true, std::memory_order_release );
+        result = true;
+      }
+
+      release();
+    }
+
+    return result;
+  }
+
+  bool Manager::commit()
+  {
+    bool result = false;
+
+    if ( initialized && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      if ( transactionOpen )
+      {
+        /*------------------------------------------------
+        An odd sequence tells readers a commit is underway. Anything they
+        read until it turns even again is discarded and read again.
+        ------------------------------------------------*/
+        commitSequence.fetch_add( 1u, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+
+        result = applyStaged();
+
+        transactionOpen.store( false, std::memory_order_release );
+        commitSequence.fetch_add( 1u, std::memory_order_release );
+
+        stagedWrites.clear();
+        stagedData.clear();
+      }
+
+      release();
+    }
+
+    return result;
+  }
+
+  bool Manager::rollback()
+  {
+    bool result = false;
+
+    if ( initialized && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      result = transactionOpen;
+
+      transactionOpen.store( false, std::memory_order_release );
+      stagedWrites.clear();
+      stagedData.clear();
+
+      release();
+    }
+
+    return result;
+  }
+
+  /*------------------------------------------------
+  Locks are always acquired in this order: index stripes in ascending
+  order, the manager lock, the cache, then a single driver.
+  ------------------------------------------------*/
+  bool Manager::lockRegistry( const Key &key, RegistryLock &lock )
+  {
+    lock.stripe = static_cast<uint8_t>( key.getHash() % INDEX_STRIPES );
+    lock.held   = !frozen.load( std::memory_order_acquire );
+
+    return !lock.held || ( indexStripes[ lock.stripe ].reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK );
+  }
+
+  bool Manager::lockRegistry( const Handle handle, RegistryLock &lock )
+  {
+    /*------------------------------------------------
+    A stale stripe is harmless, the handle then fails isActive()
+    ------------------------------------------------*/
+    lock.stripe = ( handle.slot < controlBlocks.size() ) ? slotStripes[ handle.slot ].load( std::memory_order_relaxed ) : 0u;
+    lock.held   = !frozen.load( std::memory_order_acquire );
+
+    return !lock.held || ( indexStripes[ lock.stripe ].reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK );
+  }
+
+  void Manager::unlockRegistry( const RegistryLock &lock )
+  {
+    if ( lock.held )
+    {
+      indexStripes[ lock.stripe ].release();
+    }
+  }
+
+  bool Manager::lockExclusive()
+  {
+    size_t stripes = 0;
+
+    while ( ( stripes < INDEX_STRIPES ) && ( indexStripes[ stripes ].reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      stripes++;
+    }
+
+    const bool result = ( stripes == INDEX_STRIPES ) && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK );
+
+    while ( !result && stripes )
+    {
+      indexStripes[ --stripes ].release();
+    }
+
+    return result;
+  }
+
+  void Manager::unlockExclusive()
+  {
+    release();
+
+    for ( size_t x = INDEX_STRIPES; x > 0; x-- )
+    {
+      indexStripes[ x - 1u ].release();
+    }
+  }
+
+  bool Manager::lockDriver( const StorageType storage )
+  {
+    return driverLocks[ static_cast<uint8_t>( storage ) ].reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK;
+  }
+
+  void Manager::unlockDriver( const StorageType storage )
+  {
+    driverLocks[ static_cast<uint8_t>( storage ) ].release();
+  }
+
+  uint16_t Manager::findSlot( const Key &key ) const
+  {
+    uint16_t result = INVALID_SLOT;
+
+    if ( frozen.load( std::memory_order_relaxed ) )
+    {
+      result = frozenIndex.find( key );
+    }
+    else
+    {
+      result = params.find( key );
+    }
+
+    return result;
+  }
+
+  uint8_t *Manager::directAddress( const uint16_t slot, const size_t size, const bool write ) const
+  {
+    uint8_t *result = nullptr;
+
+    /*------------------------------------------------
+    Writes to promoted parameters may need to reach their home as well
+    ------------------------------------------------*/
+    if ( ( slot != INVALID_SLOT ) && ( ControlBlockInterpreter::getStorage( controlBlocks[ slot ] ) == StorageType::INTERNAL_SRAM )
+         && ( ControlBlockInterpreter::getSize( controlBlocks[ slot ] ) == size )
+         && !( write && ( controlBlocks[ slot ].config & Tier::PROMOTED_MSK ) ) )
+    {
+      result = mappedAddress( slot );
+    }
+
+    return result;
+  }
+
+  uint8_t *Manager::mappedAddress( const uint16_t slot ) const
+  {
+    uint8_t *result = nullptr;
+
+    if ( slot != INVALID_SLOT )
+    {
+      const ControlBlock &ctrlBlk = controlBlocks[ slot ];
+      auto storage                = ControlBlockInterpreter::getStorage( ctrlBlk );
+
+      /*------------------------------------------------
+      Log structured parameters have no fixed home to point at
+      ------------------------------------------------*/
+      if ( ( storage != StorageType::NONE ) && directBase[ static_cast<uint8_t>( storage ) ]
+           && !logStores[ static_cast<uint8_t>( storage ) ] )
+      {
+        result = directBase[ static_cast<uint8_t>( storage ) ] + ControlBlockInterpreter::getAddress( ctrlBlk );
+      }
+    }
+
+    return result;
+  }
+
+  View Manager::viewSlot( const uint16_t slot, const RegistryLock &lock )
+  {
+    View result;
+
+    if ( uint8_t *const address = mappedAddress( slot ) )
+    {
+      result.data = address;
+      result.size = ControlBlockInterpreter::getSize( controlBlocks[ slot ] );
+    }
+
+    unlockRegistry( lock );
+
+    /*------------------------------------------------
+    The view reads the storage itself, so it can't see a cached write
+    ------------------------------------------------*/
+    if ( result && cache.isEnabled() && ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      Cache::Line *line = cache.find( slot );
+
+      if ( line && line->dirty && !writeBack( *line ) )
+      {
+        result = View();
+      }
+
+      cache.release();
+    }
+
+    return result;
+  }
+
+  bool Manager::isActive( const Handle handle ) const
+  {
+    return ( handle.slot < controlBlocks.size() ) && ( generations[ handle.slot ] == handle.generation );
+  }
+
+  bool Manager::queueBatch( const uint16_t slot, const size_t index )
+  {
+    bool result = false;
+
+    if ( slot != INVALID_SLOT )
+    {
+      const ControlBlock &ctrlBlk = controlBlocks[ slot ];
+      auto storage                = ControlBlockInterpreter::getStorage( ctrlBlk );
+
+      if ( ( storage != StorageType::NONE ) && memoryDriver[ static_cast<uint8_t>( storage ) ] )
+      {
+        BatchEntry entry;
+        entry.address = static_cast<uint32_t>( ControlBlockInterpreter::getAddress( ctrlBlk ) );
+        entry.size    = static_cast<uint32_t>( ControlBlockInterpreter::getSize( ctrlBlk ) );
+        entry.index     = static_cast<uint32_t>( index );
+        entry.sequence  = 0;
+        entry.slot      = slot;
+        entry.storage   = storage;
+        entry.sequenced = ControlBlockInterpreter::isSequenced( ctrlBlk );
+
+        batchEntries.push_back( entry );
+        result = true;
+      }
+    }
+
+    return result;
+  }
+
+  bool Manager::executeBatch( void *const *const readBuffers, const void *const *const writeBuffers )
+  {
+    bool result = true;
+
+    /*------------------------------------------------
+    An open transaction holds back batch writes like any other
+    ------------------------------------------------*/
+    if ( writeBuffers && transactionOpen.load( std::memory_order_acquire ) )
+    {
+      for ( const auto &entry : batchEntries )
+      {
+        bool staged = false;
+        result &= stageWrite( entry.slot, writeBuffers[ entry.index ], entry.size, true, staged ) && staged;
+      }
+
+      return result;
+    }
+
+    /*------------------------------------------------
+    Batches go straight to the drivers, so bring any cached copies in
+    line first. Reads need dirty data on the device, while writes make
+    the cached data obsolete.
+    ------------------------------------------------*/
+    if ( cache.isEnabled() )
+    {
+      const bool reserved = ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK );
+      result              = reserved;
+
+      for ( size_t x = 0; result && ( x < batchEntries.size() ); x++ )
+      {
+        Cache::Line *line = cache.find( batchEntries[ x ].slot );
+
+        if ( line && !readBuffers )
+        {
+          cache.invalidate( *line );
+        }
+        else if ( line && line->dirty )
+        {
+          result = writeBack( *line );
+        }
+      }
+
+      if ( reserved )
+      {
+        cache.release();
+      }
+    }
+
+    std::sort( batchEntries.begin(), batchEntries.end(), []( const BatchEntry &a, const BatchEntry &b ) {
+      return ( a.storage != b.storage ) ? ( a.storage < b.storage ) : ( a.address < b.address );
+    } );
+
+    size_t first = result ? 0u : batchEntries.size();
+
+    while ( first < batchEntries.size() )
+    {
+      /*------------------------------------------------
+      Grow the run while the next parameter starts exactly where the
+      previous one ended and everything still fits in the scratch buffer.
+      ------------------------------------------------*/
+      const BatchEntry &head = batchEntries[ first ];
+      LogStore *const log    = logStores[ static_cast<uint8_t>( head.storage ) ].get();
+      size_t last            = first + 1;
+      size_t runSize         = head.size;
+
+      while ( !log && ( last < batchEntries.size() ) && ( batchEntries[ last ].storage == head.storage )
+              && ( batchEntries[ last ].address == ( head.address + runSize ) )
+              && ( ( runSize + batchEntries[ last ].size ) <= batchBuffer.size() ) )
+      {
+        runSize += batchEntries[ last ].size;
+        last++;
+      }
+
+      Chimera::Modules::Memory::Device *const driver = memoryDriver[ static_cast<uint8_t>( head.storage ) ].get();
+      Chimera::Status_t error                         = Chimera::CommonStatusCodes::OK;
+
+      for ( size_t x = first; x < last; x++ )
+      {
+        BatchEntry &entry = batchEntries[ x ];
+
+        if ( entry.sequenced && writeBuffers )
+        {
+          slotWriteBegin( entry.slot );
+        }
+        else if ( entry.sequenced )
+        {
+          entry.sequence = slotReadBegin( entry.slot );
+        }
+      }
+
+      const bool serialized = !log && lockDriver( head.storage );
+
+      if ( !log && !serialized )
+      {
+        error = Chimera::CommonStatusCodes::FAIL;
+      }
+      else if ( log )
+      {
+        /*------------------------------------------------
+        Log structured parameters have no fixed address to coalesce around
+        ------------------------------------------------*/
+        const Key &key = slotKeys[ head.slot ];
+        bool logResult = false;
+
+        if ( readBuffers )
+        {
+          logResult = log->read( key, readBuffers[ head.index ], head.size );
+        }
+        else
+        {
+          logResult = log->write( key, writeBuffers[ head.index ], head.size );
+        }
+
+        error = logResult ? Chimera::CommonStatusCodes::OK : Chimera::CommonStatusCodes::FAIL;
+      }
+      else if ( ( last - first ) == 1u )
+      {
+        /*------------------------------------------------
+        Lone parameters go straight to/from the user's buffer
+        ------------------------------------------------*/
+        if ( readBuffers )
+        {
+          error = driver->read( head.address, reinterpret_cast<uint8_t *>( readBuffers[ head.index ] ), head.size );
+        }
+        else
+        {
+          error = driver->write( head.address, reinterpret_cast<const uint8_t *>( writeBuffers[ head.index ] ), head.size );
+        }
+      }
+      else if ( readBuffers )
+      {
+        error = driver->read( head.address, batchBuffer.data(), runSize );
+
+        for ( size_t x = first, offset = 0; ( error == Chimera::CommonStatusCodes::OK ) && ( x < last ); x++ )
+        {
+          memcpy( readBuffers[ batchEntries[ x ].index ], batchBuffer.data() + offset, batchEntries[ x ].size );
+          offset += batchEntries[ x ].size;
+        }
+      }
+      else
+      {
+        for ( size_t x = first, offset = 0; x < last; x++ )
+        {
+          memcpy( batchBuffer.data() + offset, writeBuffers[ batchEntries[ x ].index ], batchEntries[ x ].size );
+          offset += batchEntries[ x ].size;
+        }
+
+        error = driver->write( head.address, batchBuffer.data(), runSize );
+      }
+
+      if ( serialized )
+      {
+        unlockDriver( head.storage );
+      }
+
+      /*------------------------------------------------
+      A sequence counted parameter written during the run is read again
+      on its own until a read doesn't overlap a write
+      ------------------------------------------------*/
+      for ( size_t x = first; x < last; x++ )
+      {
+        const BatchEntry &entry = batchEntries[ x ];
+
+        if ( entry.sequenced && writeBuffers )
+        {
+          slotWriteEnd( entry.slot );
+        }
+        else if ( entry.sequenced && ( error == Chimera::CommonStatusCodes::OK )
+                  && !slotReadValidate( entry.slot, entry.sequence ) )
+        {
+          bool reread      = false;
+          uint32_t version = 0;
+
+          do
+          {
+            version = slotReadBegin( entry.slot );
+            reread  = readStorage( controlBlocks[ entry.slot ], slotKeys[ entry.slot ], readBuffers[ entry.index ] );
+          } while ( reread && !slotReadValidate( entry.slot, version ) );
+
+          error = reread ? error : Chimera::CommonStatusCodes::FAIL;
+        }
+      }
+
+      result &= ( error == Chimera::CommonStatusCodes::OK );
+      first = last;
+    }
+
+    for ( size_t x = 0; writeBuffers && ( x < batchEntries.size() ); x++ )
+    {
+      result &= writeThrough( batchEntries[ x ].slot, writeBuffers[ batchEntries[ x ].index ] );
+    }
+
+    return result;
+  }
+
+  bool Manager::readSlot( const uint16_t slot, void *const param, const size_t expectedSize, const RegistryLock &lock )
+  {
+    bool result         = false;
+    size_t address      = 0;
+    size_t size         = 0;
+    StorageType storage = StorageType::NONE;
+    Mailbox *mailbox    = nullptr;
+    bool sequenced      = false;
+    Key key;
+    std::shared_ptr<LogStore> log;
+    Chimera::Modules::Memory::Device_sPtr driver;
+
+    /*------------------------------------------------
+    Pull out only what the transfer needs while the lock is held
+    ------------------------------------------------*/
+    if ( slot != INVALID_SLOT )
+    {
+      const ControlBlock &ctrlBlk = controlBlocks[ slot ];
+      storage                     = ControlBlockInterpreter::getStorage( ctrlBlk );
+
+      size = ControlBlockInterpreter::getSize( ctrlBlk );
+      countAccess( slot, false );
+
+      if ( !expectedSize || ( expectedSize == size ) )
+      {
+        mailbox = slotMailbox( slot );
+      }
+
+      if ( ( storage != StorageType::NONE ) && ( !expectedSize || ( expectedSize == size ) ) )
+      {
+        address   = ControlBlockInterpreter::getAddress( ctrlBlk );
+        driver    = memoryDriver[ static_cast<uint8_t>( storage ) ];
+        log       = logStores[ static_cast<uint8_t>( storage ) ];
+        key       = slotKeys[ slot ];
+        sequenced = ControlBlockInterpreter::isSequenced( ctrlBlk );
+      }
+    }
+
+    unlockRegistry( lock );
+
+    Cache::Line target;
+    target.slot    = slot;
+    target.storage = static_cast<uint8_t>( storage );
+    target.address = static_cast<uint32_t>( address );
+    target.size    = static_cast<uint32_t>( size );
+
+    /*------------------------------------------------
+    Repeat the transfer if a commit, or a write to a sequence counted
+    parameter, rewrote the storage underneath it
+    ------------------------------------------------*/
+    uint32_t sequence = 0;
+    uint32_t version  = 0;
+
+    if ( mailbox )
+    {
+      mailbox->fetch( param );
+      result = true;
+    }
+    else
+    {
+      do
+      {
+        sequence = readBegin();
+        version  = sequenced ? slotReadBegin( slot ) : 0u;
+        result   = false;
+
+        if ( driver && log )
+        {
+          result = log->read( key, param, size );
+        }
+        else if ( driver && isCacheable( storage ) && cacheRead( target, param, result ) )
+        {
+          /* Handled by the cache */
+        }
+        else if ( driver && lockDriver( storage ) )
+        {
+          Chimera::Status_t error = driver->read( address, reinterpret_cast<uint8_t *>( param ), size );
+          result                  = ( error == Chimera::CommonStatusCodes::OK );
+          unlockDriver( storage );
+        }
+      } while ( driver && ( !readValidate( sequence ) || ( sequenced && !slotReadValidate( slot, version ) ) ) );
+    }
+
+    return result;
+  }
+
+  bool Manager::writeSlot( const uint16_t slot, const void *const param, const size_t expectedSize,
+                            const RegistryLock &lock )
+  {
+    bool result         = false;
+    size_t address      = 0;
+    size_t size         = 0;
+    StorageType storage = StorageType::NONE;
+    uint32_t epoch      = 0;
+    uint16_t generation = 0;
+    bool throughHome    = false;
+    bool sequenced      = false;
+    Mailbox *mailbox    = nullptr;
+    Key key;
+    ControlBlock home;
+    std::shared_ptr<LogStore> log;
+    std::shared_ptr<LogStore> homeLog;
+    Chimera::Modules::Memory::Device_sPtr driver;
+    Chimera::Modules::Memory::Device_sPtr homeDriver;
+
+    const bool staged = transactionOpen.load( std::memory_order_acquire )
+                        && stageWrite( slot, param, expectedSize, false, result );
+
+    if ( !staged && ( slot != INVALID_SLOT ) )
+    {
+      const ControlBlock &ctrlBlk = controlBlocks[ slot ];
+      storage                     = ControlBlockInterpreter::getStorage( ctrlBlk );
+
+      size = ControlBlockInterpreter::getSize( ctrlBlk );
+      countAccess( slot, true );
+
+      if ( !expectedSize || ( expectedSize == size ) )
+      {
+        mailbox = slotMailbox( slot );
+      }
+
+      if ( ( storage != StorageType::NONE ) && ( !expectedSize || ( expectedSize == size ) ) )
+      {
+        address    = ControlBlockInterpreter::getAddress( ctrlBlk );
+        driver     = memoryDriver[ static_cast<uint8_t>( storage ) ];
+        log        = logStores[ static_cast<uint8_t>( storage ) ];
+        key        = slotKeys[ slot ];
+        epoch      = tierEpoch.load();
+        generation = generations[ slot ];
+        sequenced  = ControlBlockInterpreter::isSequenced( ctrlBlk );
+
+        if ( ctrlBlk.config & Tier::PROMOTED_MSK )
+        {
+          home        = tiers[ slot ].home;
+          throughHome = isFlash( ControlBlockInterpreter::getStorage( home ) );
+          homeDriver  = memoryDriver[ static_cast<uint8_t>( ControlBlockInterpreter::getStorage( home ) ) ];
+          homeLog     = logStores[ static_cast<uint8_t>( ControlBlockInterpreter::getStorage( home ) ) ];
+        }
+      }
+    }
+
+    unlockRegistry( lock );
+
+    Cache::Line target;
+    target.slot    = slot;
+    target.storage = static_cast<uint8_t>( storage );
+    target.address = static_cast<uint32_t>( address );
+    target.size    = static_cast<uint32_t>( size );
+
+    if ( sequenced )
+    {
+      slotWriteBegin( slot );
+    }
+
+    if ( staged )
+    {
+      /* Held by the open transaction */
+    }
+    else if ( mailbox )
+    {
+      mailbox->publish( param );
+      result = true;
+    }
+    else if ( driver && log )
+    {
+      result = log->write( key, param, size );
+    }
+    else if ( driver && isCacheable( storage ) && cacheWrite( target, param, result ) )
+    {
+      /* Handled by the cache */
+    }
+    else if ( driver && lockDriver( storage ) )
+    {
+      Chimera::Status_t error = driver->write( address, reinterpret_cast<const uint8_t *>( param ), size );
+      result                  = ( error == Chimera::CommonStatusCodes::OK );
+      unlockDriver( storage );
+    }
+
+    if ( sequenced )
+    {
+      slotWriteEnd( slot );
+    }
+
+    if ( result && throughHome )
+    {
+      result = writeStorage( home, key, param, homeDriver.get(), homeLog.get() );
+    }
+
+    /*------------------------------------------------
+    A tier migration that overlapped the write may have moved the old
+    value, so repeat the write against the parameter's new location
+    ------------------------------------------------*/
+    const Handle handle( slot, generation );
+    RegistryLock relock;
+
+    if ( driver && ( tierEpoch.load() != epoch ) && lockRegistry( handle, relock ) )
+    {
+      result = writeSlot( activeSlot( handle ), param, expectedSize, relock );
+    }
+
+    return result;
+  }
+
+  uint32_t Manager::readBegin()
+  {
+    uint32_t result = commitSequence.load( std::memory_order_acquire );
+
+    while ( result & 1u )
+    {
+      if ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK )
+      {
+        release();
+      }
+
+      result = commitSequence.load( std::memory_order_acquire );
+    }
+
+    return result;
+  }
+
+  bool Manager::readValidate( const uint32_t sequence ) const
+  {
+    std::atomic_thread_fence( std::memory_order_acquire );
+    return commitSequence.load( std::memory_order_relaxed ) == sequence;
+  }
+
+  bool Manager::stageWrite( const uint16_t slot, const void *const param, const size_t expectedSize, const bool locked,
+                            bool &result )
+  {
+    bool handled = false;
+
+    /*------------------------------------------------
+    Single parameter writes only hold an index stripe, but the staging
+    area belongs to the manager lock
+    ------------------------------------------------*/
+    if ( locked || ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      /*------------------------------------------------
+      Samples are published as they arrive, not held for a commit
+      ------------------------------------------------*/
+      if ( transactionOpen && !slotMailbox( slot ) )
+      {
+        const size_t size = ( slot != INVALID_SLOT ) ? ControlBlockInterpreter::getSize( controlBlocks[ slot ] ) : 0u;
+
+        result  = ( slot != INVALID_SLOT ) && ( !expectedSize || ( expectedSize == size ) );
+        handled = true;
+
+        if ( result )
+        {
+          const size_t index = std::find_if( stagedWrites.begin(), stagedWrites.end(),
+                                             [ slot ]( const StagedWrite &staged ) { return staged.slot == slot; } )
+                               - stagedWrites.begin();
+
+          if ( index == stagedWrites.size() )
+          {
+            stagedWrites.emplace_back();
+            stagedWrites.back().size = std::numeric_limits<uint32_t>::max();
+          }
+
+          /*------------------------------------------------
+          Reuse the data area of an earlier write to the same parameter
+          ------------------------------------------------*/
+          StagedWrite &staged = stagedWrites[ index ];
+
+          if ( ( staged.size != size ) || ( staged.generation != generations[ slot ] ) )
+          {
+            staged.slot       = slot;
+            staged.generation = generations[ slot ];
+            staged.offset     = static_cast<uint32_t>( stagedData.size() );
+            staged.size       = static_cast<uint32_t>( size );
+
+            stagedData.resize( stagedData.size() + size );
+          }
+
+          memcpy( stagedData.data() + staged.offset, param, size );
+        }
+      }
+
+      if ( !locked )
+      {
+        release();
+      }
+    }
+
+    return handled;
+  }
+
+  bool Manager::applyStaged()
+  {
+    bool result = true;
+
+    /*------------------------------------------------
+    Resolve the staged writes against the current registry, dropping any
+    whose parameter was unregistered or resized in the meantime
+    ------------------------------------------------*/
+    batchEntries.clear();
+
+    for ( size_t x = 0; x < stagedWrites.size(); x++ )
+    {
+      const StagedWrite &staged = stagedWrites[ x ];
+
+      if ( ( generations[ staged.slot ] == staged.generation )
+           && ( ControlBlockInterpreter::getSize( controlBlocks[ staged.slot ] ) == staged.size ) )
+      {
+        result &= queueBatch( staged.slot, x );
+      }
+      else
+      {
+        result = false;
+      }
+    }
+
+    std::sort( batchEntries.begin(), batchEntries.end(), []( const BatchEntry &a, const BatchEntry &b ) {
+      return ( a.storage != b.storage ) ? ( a.storage < b.storage ) : ( a.address < b.address );
+    } );
+
+    /*------------------------------------------------
+    Sector images are read straight from flash, so any cached writes must
+    land first. Cached copies of the staged parameters become stale.
+    ------------------------------------------------*/
+    if ( cache.isEnabled() && ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      for ( const auto &entry : batchEntries )
+      {
+        if ( Cache::Line *line = cache.find( entry.slot ) )
+        {
+          cache.invalidate( *line );
+        }
+      }
+
+      result &= writeBackDirty();
+      cache.release();
+    }
+
+    size_t first = 0;
+
+    while ( first < batchEntries.size() )
+    {
+      const StorageType storage = batchEntries[ first ].storage;
+      const uint8_t index       = static_cast<uint8_t>( storage );
+      auto driver               = memoryDriver[ index ].get();
+      LogStore *const log       = logStores[ index ].get();
+      const size_t sectorSize   = memorySpecs[ index ].sectorSize;
+      const size_t base         = memorySpecs[ index ].startAddress;
+
+      size_t last = first;
+      while ( ( last < batchEntries.size() ) && ( batchEntries[ last ].storage == storage ) )
+      {
+        last++;
+      }
+
+      auto stagedOf = [ this ]( const BatchEntry &entry ) {
+        return stagedData.data() + stagedWrites[ entry.index ].offset;
+      };
+
+      /*------------------------------------------------
+      Hold the driver across each read-modify-write of a sector
+      ------------------------------------------------*/
+      const bool serialized = !log && lockDriver( storage );
+
+      if ( !log && !serialized )
+      {
+        result = false;
+      }
+      else if ( log || !isFlash( storage ) || !sectorSize )
+      {
+        /*------------------------------------------------
+        Nothing to gain from sector grouping, write each one out
+        ------------------------------------------------*/
+        for ( size_t x = first; x < last; x++ )
+        {
+          const BatchEntry &entry = batchEntries[ x ];
+
+          if ( log )
+          {
+            result &= log->write( slotKeys[ entry.slot ], stagedOf( entry ), entry.size );
+          }
+          else
+          {
+            result &= ( driver->write( entry.address, stagedOf( entry ), entry.size ) == Chimera::CommonStatusCodes::OK );
+          }
+        }
+      }
+      else
+      {
+        /*------------------------------------------------
+        Read-modify-write each touched sector exactly once. Parameters are
+        sorted by address, so sectors are visited in order and a parameter
+        spilling into the next sector is picked up again there.
+        ------------------------------------------------*/
+        sectorBuffer.resize( std::max( sectorBuffer.size(), sectorSize ) );
+
+        size_t x           = first;
+        size_t sectorStart = 0;
+
+        while ( x < last )
+        {
+          const BatchEntry &head = batchEntries[ x ];
+
+          if ( head.address < base )
+          {
+            result &= ( driver->write( head.address, stagedOf( head ), head.size ) == Chimera::CommonStatusCodes::OK );
+            x++;
+            continue;
+          }
+
+          sectorStart            = std::max( sectorStart, base + ( ( head.address - base ) / sectorSize ) * sectorSize );
+          const size_t sectorEnd = sectorStart + sectorSize;
+          bool sectorOk = ( driver->read( sectorStart, sectorBuffer.data(), sectorSize ) == Chimera::CommonStatusCodes::OK );
+
+          for ( size_t y = x; sectorOk && ( y < last ) && ( batchEntries[ y ].address < sectorEnd ); y++ )
+          {
+            const BatchEntry &entry = batchEntries[ y ];
+            const size_t lo         = std::max<size_t>( entry.address, sectorStart );
+            const size_t hi         = std::min<size_t>( entry.address + entry.size, sectorEnd );
+
+            if ( lo < hi )
+            {
+              memcpy( sectorBuffer.data() + ( lo - sectorStart ), stagedOf( entry ) + ( lo - entry.address ), hi - lo );
+            }
+          }
+
+          sectorOk = sectorOk && ( driver->erase( sectorStart, sectorSize ) == Chimera::CommonStatusCodes::OK )
+                     && ( driver->write( sectorStart, sectorBuffer.data(), sectorSize ) == Chimera::CommonStatusCodes::OK );
+          result &= sectorOk;
+
+          while ( ( x < last ) && ( ( batchEntries[ x ].address + batchEntries[ x ].size ) <= sectorEnd ) )
+          {
+            x++;
+          }
+
+          sectorStart = sectorEnd;
+        }
+      }
+
+      if ( serialized )
+      {
+        unlockDriver( storage );
+      }
+
+      first = last;
+    }
+
+    for ( const auto &entry : batchEntries )
+    {
+      result &= writeThrough( entry.slot, stagedData.data() + stagedWrites[ entry.index ].offset );
+    }
+
+    batchEntries.clear();
+    return result;
+  }
+
+  bool Manager::queueAsync( AsyncRequest &&request )
+  {
+    bool result         = false;
+    StorageType storage = StorageType::NONE;
+    RegistryLock lock;
+
+    /*------------------------------------------------
+    Route the request to the queue of the device it will touch
+    ------------------------------------------------*/
+    if ( initialized && lockRegistry( request.handle, lock ) )
+    {
+      if ( isActive( request.handle ) )
+      {
+        storage = ControlBlockInterpreter::getStorage( controlBlocks[ request.handle.slot ] );
+      }
+
+      unlockRegistry( lock );
+    }
+
+    if ( storage != StorageType::NONE )
+    {
+      result = asyncQueues[ static_cast<uint8_t>( storage ) ].push( std::move( request ), lockTimeout_mS );
+    }
+
+#if defined( AERO_KERNEL_PARAMETER_ASYNC_THREADS )
+    if ( result )
+    {
+      std::lock_guard<std::mutex> lock( asyncMutex );
+      asyncPending[ static_cast<uint8_t>( storage ) ] = true;
+      asyncSignal.notify_all();
+    }
+#endif
+
+    return result;
+  }
+
+  bool Manager::placeParameter( const ControlBlock &current, ControlBlock &block )
+  {
+    bool result          = true;
+    const auto storage   = ControlBlockInterpreter::getStorage( block );
+    const bool unset     = ( block.address == Placement::UNSET );
+    const bool unchanged = !( current.config & Placement::MANUAL_MSK )
+                           && ( ControlBlockInterpreter::getStorage( current ) == storage ) && ( current.size == block.size )
+                           && ( ControlBlockInterpreter::getGroup( current ) == ControlBlockInterpreter::getGroup( block ) );
+
+    if ( unset && unchanged )
+    {
+      /*------------------------------------------------
+      Keep the address previously chosen so the stored data doesn't move
+      ------------------------------------------------*/
+      block.address = current.address;
+      block.config &= ~Placement::MANUAL_MSK;
+    }
+    else
+    {
+      AddressAllocator *allocator = nullptr;
+
+      if ( ( storage != StorageType::NONE ) && !logStores[ static_cast<uint8_t>( storage ) ]
+           && allocators[ static_cast<uint8_t>( storage ) ].isEnabled() )
+      {
+        allocator = &allocators[ static_cast<uint8_t>( storage ) ];
+      }
+
+      accountPlacement( current, false );
+      block.config |= Placement::MANUAL_MSK;
+
+      if ( allocator && unset )
+      {
+        const uint32_t address = allocator->allocate( block.size, ControlBlockInterpreter::getGroup( block ) );
+
+        if ( address != AddressAllocator::INVALID_ADDRESS )
+        {
+          block.address = address;
+          block.config &= ~Placement::MANUAL_MSK;
+        }
+        else
+        {
+          accountPlacement( current, true );
+          result = false;
+        }
+      }
+      else if ( allocator )
+      {
+        allocator->claim( block.address, block.size );
+      }
+    }
+
+    return result;
+  }
+
+  void Manager::accountPlacement( const ControlBlock &block, const bool used )
+  {
+    const auto storage = ControlBlockInterpreter::getStorage( block );
+
+    if ( ( storage != StorageType::NONE ) && ( block.address != Placement::UNSET ) )
+    {
+      AddressAllocator &allocator = allocators[ static_cast<uint8_t>( storage ) ];
+
+      if ( used )
+      {
+        allocator.claim( block.address, block.size );
+      }
+      else
+      {
+        allocator.release( block.address, block.size );
+      }
+    }
+  }
 
-  Manager::Manager( const size_t lockTimeout_mS ) : initialized( false ), lockTimeout_mS( lockTimeout_mS )
+  Mailbox *Manager::slotMailbox( const uint16_t slot ) const
   {
+    Mailbox *result = nullptr;
+
+    if ( ( slot != INVALID_SLOT ) && ControlBlockInterpreter::isMailbox( controlBlocks[ slot ] ) )
+    {
+      result = mailboxes[ slot ].get();
+    }
+
+    return result;
   }
 
-  Manager::~Manager()
+  void Manager::attachMailbox( const uint16_t slot )
   {
+    const ControlBlock &ctrlBlk = controlBlocks[ slot ];
+    auto &mailbox               = mailboxes[ slot ];
+
+    if ( ControlBlockInterpreter::isMailbox( ctrlBlk ) && ( !mailbox || ( mailbox->size() != ctrlBlk.size ) ) )
+    {
+      if ( mailbox )
+      {
+        retiredMailboxes.push_back( std::move( mailbox ) );
+      }
+
+      mailbox.reset( new Mailbox( ctrlBlk.size ) );
+    }
   }
 
-  bool Manager::init( const size_t numParameters )
+  bool Manager::transferMailbox( const uint16_t slot, void *const readBuffer, const void *const writeBuffer )
   {
-    params.clear();
-    params.resize( numParameters );
-    params.set_resizing_parameters( 0.0f, 0.1f );
+    Mailbox *const mailbox = slotMailbox( slot );
 
-    memoryDriver.fill( nullptr );
+    if ( mailbox && readBuffer )
+    {
+      mailbox->fetch( readBuffer );
+    }
+    else if ( mailbox && writeBuffer )
+    {
+      mailbox->publish( writeBuffer );
+    }
 
-    initialized = true;
+    return mailbox != nullptr;
+  }
 
-    return true;
+  bool Manager::findPublished( const Key &key, Handle &handle )
+  {
+    /*------------------------------------------------
+    Announce the read before looking for a version, so any version
+    retired after this point stays alive until the read is done
+    ------------------------------------------------*/
+    const uint32_t parity = readerEpoch.load() & 1u;
+    readerCounts[ parity ].fetch_add( 1u );
+
+    const IndexVersion *const version = publishedIndex.load();
+    const bool result                 = ( version != nullptr );
+
+    if ( result )
+    {
+      /*------------------------------------------------
+      The newest change to a key shadows both older ones and the base
+      ------------------------------------------------*/
+      auto change   = std::find_if( version->recent.rbegin(), version->recent.rend(),
+                                    [ &key ]( const std::pair<Key, uint16_t> &entry ) { return entry.first == key; } );
+      uint16_t slot = ( change != version->recent.rend() ) ? change->second : version->base->find( key );
+      handle        = ( slot != INVALID_SLOT ) ? Handle( slot, version->generations[ slot ] ) : Handle();
+    }
+
+    readerCounts[ parity ].fetch_sub( 1u );
+    return result;
   }
 
-  bool Manager::registerParameter( const std::string_view &key, const ControlBlock &controlBlock )
+  void Manager::publishIndex()
   {
-    bool result = false;
+    std::shared_ptr<FlatMap> base = std::make_shared<FlatMap>();
+
+#if defined( AERO_KERNEL_PARAMETER_FLAT_MAP )
+    *base = params;
+#else
+    base->init( params.size() );
+    params.forEach( [ &base ]( const Key &key, const uint16_t slot ) { base->insert( key, slot ); } );
+#endif
+
+    indexBase = std::move( base );
+    indexRecent.clear();
+    installIndex();
+  }
 
+  void Manager::publishChange( const Key &key, const uint16_t slot )
+  {
     /*------------------------------------------------
-    If the key does not exist in the map, it will be added. Otherwise
-    the existing key will be accessed and the value updated.
+    Rebuilding the base only every INDEX_RECENT_LIMIT changes keeps a burst
+    of registrations from copying the whole index each time
     ------------------------------------------------*/
-    if ( initialized && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    if ( !indexBase || ( indexRecent.size() >= INDEX_RECENT_LIMIT ) )
     {
-      params[ key ] = controlBlock;
-      release();
-      result = true;
+      publishIndex();
+    }
+    else
+    {
+      indexRecent.emplace_back( key, slot );
+      installIndex();
     }
+  }
 
-    return result;
+  void Manager::installIndex()
+  {
+    std::unique_ptr<IndexVersion> version( new IndexVersion() );
+    version->base        = indexBase;
+    version->recent      = indexRecent;
+    version->generations = generations;
+
+    IndexVersion *const previous = publishedIndex.exchange( version.release() );
+
+    if ( previous )
+    {
+      retiredIndexes.emplace_back( previous );
+    }
+
+    reclaimIndexes();
   }
 
-  bool Manager::unregisterParameter( const std::string_view &key )
+  void Manager::retireIndex()
   {
-    bool result = false;
+    IndexVersion *const version = publishedIndex.exchange( nullptr );
 
-    if ( initialized && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    if ( version )
     {
-      result = params.erase( key ) > 0;
-      release();
+      retiredIndexes.emplace_back( version );
+    }
+
+    reclaimIndexes();
+  }
+
+  void Manager::reclaimIndexes()
+  {
+    if ( !retiredIndexes.empty() )
+    {
+      /*------------------------------------------------
+      An idle parity means every reader that might have seen a version
+      retired before now has finished
+      ------------------------------------------------*/
+      for ( uint8_t parity = 0; parity < readerCounts.size(); parity++ )
+      {
+        if ( !readerCounts[ parity ].load() )
+        {
+          for ( auto &version : retiredIndexes )
+          {
+            version->drained |= static_cast<uint8_t>( 1u << parity );
+          }
+        }
+      }
+
+      retiredIndexes.erase( std::remove_if( retiredIndexes.begin(), retiredIndexes.end(),
+                                            []( const std::unique_ptr<IndexVersion> &version ) { return version->drained == 0x3; } ),
+                            retiredIndexes.end() );
+
+      /*------------------------------------------------
+      New readers move to the other parity, letting this one drain
+      ------------------------------------------------*/
+      if ( !retiredIndexes.empty() )
+      {
+        readerEpoch++;
+      }
+    }
+  }
+
+  bool Manager::promoteSlot( const uint16_t slot )
+  {
+    bool result               = false;
+    const ControlBlock &home  = controlBlocks[ slot ];
+    const Key &key            = slotKeys[ slot ];
+    const uint8_t sram        = static_cast<uint8_t>( StorageType::INTERNAL_SRAM );
+    AddressAllocator &sramMap = allocators[ sram ];
+
+    if ( memoryDriver[ sram ] && !logStores[ sram ] && sramMap.isEnabled() )
+    {
+      const uint32_t address = sramMap.allocate( home.size, ControlBlockInterpreter::getGroup( home ) );
+
+      if ( address != AddressAllocator::INVALID_ADDRESS )
+      {
+        /*------------------------------------------------
+        Make sure the home holds the latest value, then copy it over
+        ------------------------------------------------*/
+        if ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK )
+        {
+          evictSlot( slot );
+          cache.release();
+        }
+
+        ControlBlock block = home;
+        block.address      = address;
+        block.config       = ( block.config & ~( Location::MEM_LOC_MSK | Placement::MANUAL_MSK ) ) | Location::INTERNAL_SRAM
+                       | Tier::PROMOTED_MSK;
+
+        tierBuffer.resize( std::max<size_t>( tierBuffer.size(), home.size ) );
+        result = readStorage( home, key, tierBuffer.data() ) && writeStorage( block, key, tierBuffer.data() );
+
+        if ( result )
+        {
+          tiers[ slot ].home    = home;
+          controlBlocks[ slot ] = block;
+        }
+        else
+        {
+          sramMap.release( address, home.size );
+        }
+      }
     }
 
     return result;
   }
 
-  bool Manager::isRegistered( const std::string_view &key )
+  bool Manager::demoteSlot( const uint16_t slot )
   {
-    bool result = false;
+    bool result               = true;
+    const ControlBlock &block = controlBlocks[ slot ];
+    ControlBlock home         = tiers[ slot ].home;
 
-    if ( initialized && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    /*------------------------------------------------
+    Flash homes are kept current by write through, but volatile
+    homes have to be brought up to date
+    ------------------------------------------------*/
+    if ( !isFlash( ControlBlockInterpreter::getStorage( home ) ) )
     {
-      result = params.contains( key );
-      release();
+      const Key &key = slotKeys[ slot ];
+
+      tierBuffer.resize( std::max<size_t>( tierBuffer.size(), block.size ) );
+      result = readStorage( block, key, tierBuffer.data() ) && writeStorage( home, key, tierBuffer.data() );
+    }
+
+    if ( result )
+    {
+      home.callback = block.callback;
+      tierRetired.push_back( block );
+      controlBlocks[ slot ] = home;
     }
 
     return result;
   }
 
-  bool Manager::read( const std::string_view &key, void *const param )
+  const ControlBlock &Manager::homeBlock( const uint16_t slot ) const
+  {
+    return ( controlBlocks[ slot ].config & Tier::PROMOTED_MSK ) ? tiers[ slot ].home : controlBlocks[ slot ];
+  }
+
+  bool Manager::writeThrough( const uint16_t slot, const void *const param )
   {
     bool result = true;
 
-    if ( !initialized || !param || !params.contains( key ) || ( reserve( lockTimeout_mS ) != Chimera::CommonStatusCodes::OK ) )
+    if ( ( controlBlocks[ slot ].config & Tier::PROMOTED_MSK )
+         && isFlash( ControlBlockInterpreter::getStorage( tiers[ slot ].home ) ) )
     {
-      result = false;
+      result = writeStorage( tiers[ slot ].home, slotKeys[ slot ], param );
     }
-    else
+
+    return result;
+  }
+
+  bool Manager::readStorage( const ControlBlock &block, const Key &key, void *const param )
+  {
+    bool result        = false;
+    const auto storage = ControlBlockInterpreter::getStorage( block );
+
+    if ( storage != StorageType::NONE )
     {
-      auto ctrlBlk = params[ key ];
-      auto storage = ControlBlockInterpreter::getStorage( ctrlBlk );
-      auto driver  = memoryDriver[ static_cast<uint8_t>( storage ) ];
-      release();
+      auto driver         = memoryDriver[ static_cast<uint8_t>( storage ) ].get();
+      LogStore *const log = logStores[ static_cast<uint8_t>( storage ) ].get();
+
+      if ( driver && log )
+      {
+        result = log->read( key, param, block.size );
+      }
+      else if ( driver && lockDriver( storage ) )
+      {
+        result = ( driver->read( block.address, reinterpret_cast<uint8_t *>( param ), block.size )
+                   == Chimera::CommonStatusCodes::OK );
+        unlockDriver( storage );
+      }
+    }
+
+    return result;
+  }
+
+  bool Manager::writeStorage( const ControlBlock &block, const Key &key, const void *const param )
+  {
+    bool result        = false;
+    const auto storage = ControlBlockInterpreter::getStorage( block );
+
+    if ( storage != StorageType::NONE )
+    {
+      result = writeStorage( block, key, param, memoryDriver[ static_cast<uint8_t>( storage ) ].get(),
+                             logStores[ static_cast<uint8_t>( storage ) ].get() );
+    }
+
+    return result;
+  }
+
+  bool Manager::writeStorage( const ControlBlock &block, const Key &key, const void *const param,
+                              Chimera::Modules::Memory::Device *const driver, LogStore *const log )
+  {
+    bool result        = false;
+    const auto storage = ControlBlockInterpreter::getStorage( block );
+
+    if ( driver && log )
+    {
+      result = log->write( key, param, block.size );
+    }
+    else if ( driver && lockDriver( storage ) )
+    {
+      result = ( driver->write( block.address, reinterpret_cast<const uint8_t *>( param ), block.size )
+                 == Chimera::CommonStatusCodes::OK );
+      unlockDriver( storage );
+    }
+
+    return result;
+  }
+
+  StorageType Manager::plainAccess( const uint16_t slot, const size_t size, const bool write, size_t &address ) const
+  {
+    StorageType result = StorageType::NONE;
+
+    if ( slot != INVALID_SLOT )
+    {
+      const ControlBlock &ctrlBlk = controlBlocks[ slot ];
+      const auto storage          = ControlBlockInterpreter::getStorage( ctrlBlk );
+
+      /*------------------------------------------------
+      Writes race with tier migrations unless nothing can move
+      ------------------------------------------------*/
+      const bool fixed = !write
+                         || ( !transactionOpen.load( std::memory_order_acquire ) && !( ctrlBlk.config & Tier::PROMOTED_MSK )
+                              && ( !accessCounts || frozen.load( std::memory_order_relaxed ) ) );
+
+      if ( fixed && ( storage != StorageType::NONE ) && ( ControlBlockInterpreter::getSize( ctrlBlk ) == size )
+           && ( boundDrivers & ( 1u << static_cast<uint8_t>( storage ) ) ) && !logStores[ static_cast<uint8_t>( storage ) ]
+           && !( cache.isEnabled() && isCacheable( storage ) ) )
+      {
+        address = ControlBlockInterpreter::getAddress( ctrlBlk );
+        result  = storage;
+      }
+    }
+
+    return result;
+  }
+
+  bool Manager::isCacheable( const StorageType storage ) const
+  {
+    return isFlash( storage ) && !logStores[ static_cast<uint8_t>( storage ) ];
+  }
+
+  bool Manager::cacheRead( const Cache::Line &target, void *const param, bool &result )
+  {
+    bool handled = false;
+
+    if ( cache.isEnabled() && ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      bool hit          = false;
+      Cache::Line *line = cache.canHold( target.size ) ? cacheLine( target, hit ) : nullptr;
+
+      /*------------------------------------------------
+      A commit invalidates the lines it covers before rewriting storage, so
+      anything read while the sequence is odd may be stale. The read still
+      goes ahead and is retried by the caller, but must not fill the line.
+      ------------------------------------------------*/
+      const bool committing = ( commitSequence.load( std::memory_order_acquire ) & 1u ) != 0u;
 
-      if ( driver )
+      if ( line && !hit )
       {
-        Chimera::Status_t error = driver->read( ctrlBlk.address, reinterpret_cast<uint8_t *const>( param ), ctrlBlk.size );
+        /*------------------------------------------------
+        Fill the line on a miss. The line is left empty if the driver fails.
+        ------------------------------------------------*/
+        const auto storage = static_cast<StorageType>( target.storage );
+        auto driver        = memoryDriver[ target.storage ].get();
+        uint8_t *const dst = committing ? reinterpret_cast<uint8_t *>( param ) : cache.data( *line );
+
+        if ( lockDriver( storage ) )
+        {
+          hit = ( driver->read( target.address, dst, target.size ) == Chimera::CommonStatusCodes::OK );
+          unlockDriver( storage );
+        }
 
-        if ( error != Chimera::CommonStatusCodes::OK )
+        if ( hit && !committing )
         {
-          result = false;
+          cache.assign( *line, target.slot, target.storage, target.address, target.size );
+          memcpy( param, cache.data( *line ), target.size );
+        }
+        else
+        {
+          cache.invalidate( *line );
         }
+
+        result  = hit;
+        handled = true;
       }
-      else
+      else if ( line )
       {
-        result = false;
+        memcpy( param, cache.data( *line ), target.size );
+        result  = true;
+        handled = true;
       }
+
+      cache.release();
     }
 
-    return result;
+    return handled;
   }
 
-  bool Manager::write( const std::string_view &key, const void *const param )
+  bool Manager::cacheWrite( const Cache::Line &target, const void *const param, bool &result )
   {
-    bool result = false;
+    bool handled = false;
 
-    if ( initialized && param && params.contains( key ) && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    if ( cache.isEnabled() && ( cache.reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
     {
-      auto ctrlBlk = params[ key ];
-      auto storage = ControlBlockInterpreter::getStorage( ctrlBlk );
-      auto driver  = memoryDriver[ static_cast<uint8_t>( storage ) ];
-      release();
+      bool hit          = false;
+      Cache::Line *line = cache.canHold( target.size ) ? cacheLine( target, hit ) : nullptr;
 
-      if ( driver )
+      if ( line )
       {
-        Chimera::Status_t error = driver->write( ctrlBlk.address, reinterpret_cast<const uint8_t *const>( param ),
-                                                 ctrlBlk.size );
-        result                  = ( error == Chimera::CommonStatusCodes::OK );
+        /*------------------------------------------------
+        The whole parameter is overwritten, so a miss never needs a fill
+        ------------------------------------------------*/
+        if ( !hit )
+        {
+          cache.assign( *line, target.slot, target.storage, target.address, target.size );
+        }
+
+        memcpy( cache.data( *line ), param, target.size );
+        cache.setDirty( *line, true );
+        result      = true;
+        handled     = true;
       }
+
+      cache.release();
     }
 
-    return result;
+    return handled;
   }
 
-  bool Manager::update( const std::string_view &key )
+  Cache::Line *Manager::cacheLine( const Cache::Line &target, bool &hit )
   {
-    bool result = false;
+    Cache::Line *result = cache.find( target.slot );
 
-    if ( initialized && params.contains( key ) )
+    /*------------------------------------------------
+    The slot may have been re-registered while the transfer was in flight,
+    in which case the line describes a parameter that no longer exists.
+    ------------------------------------------------*/
+    if ( result && ( ( result->storage != target.storage ) || ( result->address != target.address )
+                     || ( result->size != target.size ) ) )
+    {
+      evictSlot( target.slot );
+      result = nullptr;
+    }
+
+    hit = ( result != nullptr );
+
+    if ( !result )
     {
-      auto ctrlBlk = params[ key ];
-      auto updateFunc = ControlBlockInterpreter::getUpdateCallback( ctrlBlk );
+      Cache::Line &victim = cache.victim();
 
-      if ( updateFunc )
+      if ( !victim.dirty || writeBack( victim ) )
       {
-        result = updateFunc( key );
+        result = &victim;
       }
     }
 
     return result;
   }
 
-  bool Manager::registerMemoryDriver( const StorageType storage, Chimera::Modules::Memory::Device_sPtr &driver )
+  bool Manager::writeBack( Cache::Line &line )
   {
-    bool result = false;
+    bool result        = false;
+    const auto storage = static_cast<StorageType>( line.storage );
+    auto driver        = memoryDriver[ line.storage ].get();
 
-    if ( initialized && ( storage != StorageType::NONE )
-         && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    if ( driver && lockDriver( storage ) )
     {
-      memoryDriver[ static_cast<uint8_t>(storage) ] = driver;
-      release();
-      result = true;
+      result = ( driver->write( line.address, cache.data( line ), line.size ) == Chimera::CommonStatusCodes::OK );
+      unlockDriver( storage );
+    }
+
+    if ( result )
+    {
+      cache.setDirty( line, false );
     }
 
     return result;
   }
 
-  bool Manager::registerMemorySpecs( const StorageType storage, const Chimera::Modules::Memory::Descriptor &specs )
+  bool Manager::writeBackDirty()
   {
-    bool result = false;
+    bool result = true;
 
-    if ( initialized && ( storage != StorageType::NONE )
-         && ( reserve( lockTimeout_mS ) == Chimera::CommonStatusCodes::OK ) )
+    /*------------------------------------------------
+    Gather the pending writes from the dirty bitmap and put them in device
+    address order, so the storage is swept front to back
+    ------------------------------------------------*/
+    persistOrder.clear();
+    cache.forEachDirty( [ this ]( Cache::Line &line ) { persistOrder.push_back( &line ); } );
+
+    std::sort( persistOrder.begin(), persistOrder.end(), []( const Cache::Line *a, const Cache::Line *b ) {
+      return ( a->storage != b->storage ) ? ( a->storage < b->storage ) : ( a->address < b->address );
+    } );
+
+    size_t first = 0;
+
+    while ( first < persistOrder.size() )
     {
-      memorySpecs[ static_cast<uint8_t>( storage ) ] = specs;
-      release();
-      result = true;
+      /*------------------------------------------------
+      Parameters that sit back to back on the same device are written
+      with a single transaction
+      ------------------------------------------------*/
+      const Cache::Line &head = *persistOrder[ first ];
+      size_t last             = first + 1;
+      size_t runSize          = head.size;
+
+      while ( ( last < persistOrder.size() ) && ( persistOrder[ last ]->storage == head.storage )
+              && ( persistOrder[ last ]->address == ( head.address + runSize ) )
+              && ( ( runSize + persistOrder[ last ]->size ) <= persistBuffer.size() ) )
+      {
+        runSize += persistOrder[ last ]->size;
+        last++;
+      }
+
+      if ( ( last - first ) == 1u )
+      {
+        result &= writeBack( *persistOrder[ first ] );
+      }
+      else
+      {
+        auto driver = memoryDriver[ head.storage ].get();
+
+        for ( size_t x = first, offset = 0; x < last; x++ )
+        {
+          memcpy( persistBuffer.data() + offset, cache.data( *persistOrder[ x ] ), persistOrder[ x ]->size );
+          offset += persistOrder[ x ]->size;
+        }
+
+        const auto storage = static_cast<StorageType>( head.storage );
+        bool written       = false;
+
+        if ( driver && lockDriver( storage ) )
+        {
+          written = ( driver->write( head.address, persistBuffer.data(), runSize ) == Chimera::CommonStatusCodes::OK );
+          unlockDriver( storage );
+        }
+
+        for ( size_t x = first; written && ( x < last ); x++ )
+        {
+          cache.setDirty( *persistOrder[ x ], false );
+        }
+
+        result &= written;
+      }
+
+      first = last;
     }
 
     return result;
   }
 
-  const AeroKernel::Parameter::ControlBlock &Manager::getControlBlock( const std::string_view &key )
+  void Manager::evictSlot( const uint16_t slot )
   {
-    return params[ key ];
+    if ( Cache::Line *line = cache.find( slot ) )
+    {
+      if ( line->dirty )
+      {
+        writeBack( *line );
+      }
+
+      cache.invalidate( *line );
+    }
   }
 
   AeroKernel::Parameter::ControlBlock ControlBlockFactory::build()
@@ -221,31 +3605,27 @@ namespace AeroKernel::Parameter
     clear();
   }
 
-  ControlBlockFactory::~ControlBlockFactory()
-  {
-  }
-
   void ControlBlockFactory::clear()
   {
-    mold.address = std::numeric_limits<decltype( ControlBlock::address )>::max();
-    mold.config  = std::numeric_limits<decltype( ControlBlock::config )>::max();
-    mold.size    = std::numeric_limits<decltype( ControlBlock::size )>::min();
-    mold.update  = nullptr;
+    mold.address  = std::numeric_limits<decltype( ControlBlock::address )>::max();
+    mold.config   = std::numeric_limits<decltype( ControlBlock::config )>::max();
+    mold.size     = std::numeric_limits<decltype( ControlBlock::size )>::min();
+    mold.callback = CallbackRef();
   }
 
   void ControlBlockFactory::setSize( const size_t size )
   {
-    mold.size = size;
+    mold.size = static_cast<decltype( ControlBlock::size )>( size );
   }
 
   void ControlBlockFactory::setAddress( const size_t address )
   {
-    mold.address = address;
+    mold.address = static_cast<decltype( ControlBlock::address )>( address );
   }
 
   void ControlBlockFactory::setStorage( const StorageType type )
   {
-    size_t bitSettings;
+    uint32_t bitSettings;
 
     switch ( type )
     {
@@ -290,9 +3670,39 @@ namespace AeroKernel::Parameter
     mold.config |= bitSettings;
   }
 
+  void ControlBlockFactory::setGroup( const uint8_t group )
+  {
+    mold.config &= ~( Placement::GROUP_MSK );
+    mold.config |= ( static_cast<uint32_t>( group ) << Placement::GROUP_POS ) & Placement::GROUP_MSK;
+  }
+
   void ControlBlockFactory::setUpdateCallback( UpdateCallback_t callback )
   {
-    mold.update = callback;
+    mold.callback = CallbackRef( Callback::registry().acquire( callback ) );
+  }
+
+  void ControlBlockFactory::setMailbox( const bool mailbox )
+  {
+    if ( mailbox )
+    {
+      mold.config &= ~Stream::MAILBOX_MSK;
+    }
+    else
+    {
+      mold.config |= Stream::MAILBOX_MSK;
+    }
+  }
+
+  void ControlBlockFactory::setSequenced( const bool sequenced )
+  {
+    if ( sequenced )
+    {
+      mold.config &= ~Consistency::SEQUENCED_MSK;
+    }
+    else
+    {
+      mold.config |= Consistency::SEQUENCED_MSK;
+    }
   }
 
 
@@ -353,9 +3763,24 @@ namespace AeroKernel::Parameter
     return ctrlBlk.size;
   }
 
+  uint8_t ControlBlockInterpreter::getGroup( const ControlBlock &ctrlBlk )
+  {
+    return static_cast<uint8_t>( ( ctrlBlk.config & Placement::GROUP_MSK ) >> Placement::GROUP_POS );
+  }
+
+  bool ControlBlockInterpreter::isSequenced( const ControlBlock &ctrlBlk )
+  {
+    return !( ctrlBlk.config & Consistency::SEQUENCED_MSK );
+  }
+
+  bool ControlBlockInterpreter::isMailbox( const ControlBlock &ctrlBlk )
+  {
+    return !( ctrlBlk.config & Stream::MAILBOX_MSK );
+  }
+
   AeroKernel::Parameter::UpdateCallback_t ControlBlockInterpreter::getUpdateCallback( const ControlBlock &ctrlBlk )
   {
-    return ctrlBlk.update;
+    return Callback::registry().get( ctrlBlk.callback.get() );
   }
 
 }  // namespace AeroKernel::Parameter
@@ -36,18 +36,39 @@
 #define AERO_KERNEL_PARAMETER_MANAGER_HPP
 
 /* C++ Includes */
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <functional>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
-/* Hash Map Include */
-#include <sparsepp/spp.h>
+/* AeroKernel Includes */
+#include <AeroKernel/parameter_key.hpp>
+#include <AeroKernel/parameter_index.hpp>
+#include <AeroKernel/parameter_alloc.hpp>
+#include <AeroKernel/parameter_async.hpp>
+#include <AeroKernel/parameter_cache.hpp>
+#include <AeroKernel/parameter_log.hpp>
+#include <AeroKernel/parameter_mailbox.hpp>
 
 /* Chimera Includes */
 #include <Chimera/modules/memory/device.hpp>
 #include <Chimera/threading.hpp>
 
+/* Worker Thread Includes */
+#if defined( AERO_KERNEL_PARAMETER_ASYNC_THREADS )
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#endif
+
 namespace AeroKernel::Parameter
 {
   enum class StorageType : uint8_t
@@ -66,49 +87,206 @@ namespace AeroKernel::Parameter
 
   using UpdateCallback_t = std::function<bool( const std::string_view &key )>;
 
+  /**
+   *  Counted reference to an update callback held in the Manager's side
+   *  table. Every copy keeps the callback alive, so a ControlBlock stays
+   *  valid after the factory that built it is gone.
+   */
+  class CallbackRef
+  {
+  public:
+    CallbackRef() = default;
+    CallbackRef( const CallbackRef &other );
+    CallbackRef( CallbackRef &&other ) noexcept;
+    CallbackRef &operator=( const CallbackRef &other );
+    CallbackRef &operator=( CallbackRef &&other ) noexcept;
+    ~CallbackRef();
+
+    /**
+     *	Gets the raw side table reference
+     *
+     *	@return uint32_t
+     */
+    uint32_t get() const
+    {
+      return reference;
+    }
+
+  private:
+    friend class ControlBlockFactory;
+
+    /**
+     *	Takes over a reference the side table has already counted
+     *
+     *	@param[in]	reference The reference to adopt
+     */
+    explicit CallbackRef( const uint32_t reference ) : reference( reference )
+    {
+    }
+
+    uint32_t reference = std::numeric_limits<uint32_t>::max();
+  };
+
   /**
    *  Data structure that fully describes a parameter that is stored
    *  somewhere in memory. This could be volatile or non-volatile
    *  memory, it does not matter. The actual data is not stored in
    *  this block, only the meta information describing it.
    *
+   *  The block is packed into four 32-bit words so that thousands of
+   *  parameters can be registered cheaply and several blocks share a cache
+   *  line. Always use ControlBlockFactory and ControlBlockInterpreter to
+   *  create and decode it, as the encoding is not part of the public API.
+   *
    *  @requirement PM002.2
    */
   struct ControlBlock
   {
     /**
-     *  The size of the data this control block describes.
+     *  The address in memory the data should be stored at. Whether
+     *  or not the address is valid is highly dependent upon the
+     *  storage sink used. Left unset, the Manager picks an address
+     *  inside the region given to registerMemorySpecs().
      */
-    size_t size = std::numeric_limits<size_t>::max();
+    uint32_t address = std::numeric_limits<uint32_t>::max();
 
     /**
-     *  The address in memory the data should be stored at. Whether
-     *  or not the address is valid is highly dependent upon the
-     *  storage sink used.
+     *  The size of the data this control block describes.
      */
-    size_t address = std::numeric_limits<size_t>::max();
+    uint32_t size = std::numeric_limits<uint32_t>::max();
 
     /**
      *  Configuration Options:
-     *    Bits 0-2: Memory Storage Location, see MemoryLocation
+     *    Bits 0-3: Memory Storage Location
+     *    Bits 4-7: Placement Group
+     *    Bit 8:    Address Chosen By User (active low, set by the Manager)
+     *    Bit 9:    Promoted Into The INTERNAL_SRAM Tier (set by the Manager)
+     *    Bit 10:   Sequence Counted (active low)
+     *    Bit 11:   Triple Buffered Mailbox (active low)
      *
      *  @requirement PM002.2.1, PM002.2.2, PM002.2.3
      */
-    size_t config = std::numeric_limits<size_t>::max();
+    uint32_t config = std::numeric_limits<uint32_t>::max();
 
     /**
-     *  Optional function that can be used by client applications
-     *  to request an update of the parameter. This allows fresh
-     *  data to be acquired on demand.
+     *  Reference into the side table of update callbacks. Most parameters
+     *  do not have an update function, so it is stored out of line rather
+     *  than paying for a std::function in every block.
      *
      *  @requirement PM002.3
      */
-    UpdateCallback_t update = nullptr;
+    CallbackRef callback;
   };
 
+  static_assert( sizeof( ControlBlock ) == 16, "ControlBlock encoding is expected to be 16 bytes" );
+
   using ParamCtrlBlk_sPtr = std::shared_ptr<ControlBlock>;
   using ParamCtrlBlk_uPtr = std::unique_ptr<ControlBlock>;
 
+  /**
+   *  Opaque reference to a registered parameter. A handle is resolved once,
+   *  either when the parameter is registered or through Manager::getHandle(),
+   *  and afterwards gives direct access to the parameter's control block
+   *  without touching the hash map. Handles to a parameter that has since been
+   *  unregistered are detected and rejected.
+   */
+  class Handle
+  {
+  public:
+    constexpr Handle() : slot( INVALID_SLOT ), generation( 0 )
+    {
+    }
+
+    /**
+     *	Checks if the handle references a parameter. This does not guarantee
+     *  that the parameter is still registered with the Manager.
+     */
+    constexpr explicit operator bool() const
+    {
+      return slot != INVALID_SLOT;
+    }
+
+    constexpr bool operator==( const Handle &rhs ) const
+    {
+      return ( slot == rhs.slot ) && ( generation == rhs.generation );
+    }
+
+    constexpr bool operator!=( const Handle &rhs ) const
+    {
+      return !( *this == rhs );
+    }
+
+  private:
+    friend class Manager;
+
+    constexpr Handle( const uint16_t slot, const uint16_t generation ) : slot( slot ), generation( generation )
+    {
+    }
+
+    uint16_t slot;       /**< Index into the Manager's control block array */
+    uint16_t generation; /**< Registration count of the slot when the handle was created */
+  };
+
+  using VisitCallback_t = std::function<void( const Key &key, const Handle handle )>;
+
+  /**
+   *  Invoked once an asynchronous transfer completes, from the context that
+   *  serviced the request
+   */
+  using AsyncCallback_t = std::function<void( const Handle handle, const bool success )>;
+
+  /**
+   *  Read only window onto a parameter's data in memory mapped storage,
+   *  returned by Manager::view(). It refers to the storage itself, so the
+   *  contents change whenever the parameter is written.
+   */
+  struct View
+  {
+    const uint8_t *data = nullptr;
+    size_t size         = 0;
+
+    constexpr explicit operator bool() const
+    {
+      return data != nullptr;
+    }
+
+    constexpr const uint8_t *begin() const
+    {
+      return data;
+    }
+
+    constexpr const uint8_t *end() const
+    {
+      return data + size;
+    }
+  };
+
+  /**
+   *  Controls automatic promotion of frequently accessed parameters from slow
+   *  external memory into INTERNAL_SRAM. Access counts are aged by half on
+   *  every Manager::rebalanceTiers(), so the thresholds are roughly accesses
+   *  per rebalance period.
+   */
+  struct TieringConfig
+  {
+    uint32_t promoteThreshold = 0; /**< Parameters at least this hot are promoted */
+    uint32_t demoteThreshold  = 0; /**< Promoted parameters colder than this are sent back home */
+    size_t maxPromoted        = 0; /**< Most parameters promoted at once, zero disables tiering */
+  };
+
+  /**
+   *  Access statistics of a single parameter, see Manager::getAccessStats()
+   */
+  struct AccessStats
+  {
+    uint32_t reads      = 0;                 /**< Reads since registration or tiering was enabled */
+    uint32_t writes     = 0;                 /**< Writes since registration or tiering was enabled */
+    uint32_t heat       = 0;                 /**< Aged access count used to rank parameters */
+    StorageType storage = StorageType::NONE; /**< Where the parameter is currently served from */
+    StorageType home    = StorageType::NONE; /**< Where the parameter was registered to live */
+    bool promoted       = false;             /**< Currently held in the INTERNAL_SRAM tier */
+  };
+
   /**
    *  A generator for the control block data structure. Currently
    *  it's quite simple, but the data type is likely to change in 
@@ -118,7 +296,6 @@ namespace AeroKernel::Parameter
   {
   public:
     ControlBlockFactory();
-    ~ControlBlockFactory();
 
     /**
      *	Compiles all the current settings and returns the fully
@@ -137,7 +314,7 @@ namespace AeroKernel::Parameter
 
     /**
      *	Encodes the sizing information associated with the parameter this
-     *  control block describes.
+     *  control block describes. Sizes are limited to 32 bits.
      *
      *	@param[in]	size      The size of the parameter
      *	@return void
@@ -145,7 +322,7 @@ namespace AeroKernel::Parameter
     void setSize( const size_t size );
 
     /**
-     *	Encodes the address information
+     *	Encodes the address information. Addresses are limited to 32 bits.
      *
      *	@param[in]	address   The address the parameter will be stored at in NVM
      *	@return void
@@ -161,13 +338,51 @@ namespace AeroKernel::Parameter
     void setStorage( const StorageType type );
 
     /**
-     *	Attaches an optional update function
+     *  Hints that the parameter is accessed together with the other members
+     *  of a group. When the Manager assigns addresses, members of a group are
+     *  packed into the same pages and sectors so they can be read or saved
+     *  with as few flash transactions as possible.
+     *
+     *	@param[in]	group     Group number, 0-14
+     *	@return void
+     */
+    void setGroup( const uint8_t group );
+
+    /**
+     *	Attaches an optional update function. The function is stored in a
+     *  shared side table and only referenced from the control block.
      *
      *	@param[in]	callback  The update function to attach
      *	@return void
      */
     void setUpdateCallback( UpdateCallback_t callback );
 
+    /**
+     *	Guards the parameter with its own sequence counter. Reads that overlap
+     *  a write are repeated instead of returning a mix of old and new data,
+     *  and the writer never waits on a reader. Use it for multi-word values,
+     *  such as a quaternion, that are read by one task while another writes
+     *  them. Only one task may write a sequence counted parameter at a time.
+     *
+     *	@param[in]	sequenced True to enable the sequence counter
+     *	@return void
+     */
+    void setSequenced( const bool sequenced );
+
+    /**
+     *	Stores the parameter in a triple buffered mailbox held in the Manager's
+     *  own memory instead of on a storage device, for streams of samples with
+     *  one producer and any number of consumers. Writes publish a new sample
+     *  and reads return the newest complete one, with neither side waiting on
+     *  the other. The storage and address are ignored, samples are never
+     *  saved to a registry image, and writes take effect immediately even
+     *  inside a transaction. Only one task may write a mailbox at a time.
+     *
+     *	@param[in]	mailbox   True to store the parameter in a mailbox
+     *	@return void
+     */
+    void setMailbox( const bool mailbox );
+
   private:
     ControlBlock mold;
   };
@@ -190,6 +405,12 @@ namespace AeroKernel::Parameter
 
     static size_t getSize( const ControlBlock &ctrlBlk );
 
+    static uint8_t getGroup( const ControlBlock &ctrlBlk );
+
+    static bool isSequenced( const ControlBlock &ctrlBlk );
+
+    static bool isMailbox( const ControlBlock &ctrlBlk );
+
     static UpdateCallback_t getUpdateCallback( const ControlBlock &ctrlBlk );
   };
 
@@ -222,15 +443,24 @@ namespace AeroKernel::Parameter
     bool init( const size_t numParameters );
 
     /**
-     *  Registers a new parameter into the manager
+     *  Registers a new parameter into the manager. Registering a key that already
+     *  exists updates its control block and returns the existing handle. The
+     *  Manager stores its own copy of the name, so the key's characters do not
+     *  need to outlive this call.
+     *
+     *  If the control block has no address and the storage has memory specs,
+     *  the Manager allocates one that respects the device's page and sector
+     *  boundaries. Re-registering the parameter with the same storage, size
+     *  and group keeps the address it was given.
      *
      *  @requirement PM002, PM002.1
      *
      *	@param[in]	key             The parameter's name
      *	@param[in]	controlBlock    Information describing where the parameter lives in memory
-     *	@return bool
+     *	@return Handle              Evaluates to false if the parameter could not be registered
      */
-    bool registerParameter( const std::string_view &key, const ControlBlock &controlBlock );
+    Handle registerParameter( const std::string_view &key, const ControlBlock &controlBlock );
+    Handle registerParameter( const Key &key, const ControlBlock &controlBlock );
 
     /**
      *  Removes a parameter from the manager
@@ -241,9 +471,11 @@ namespace AeroKernel::Parameter
      *	@return bool
      */
     bool unregisterParameter( const std::string_view &key );
+    bool unregisterParameter( const Key &key );
 
     /**
-     *  Checks if the given parameter has been registered
+     *  Checks if the given parameter has been registered. Like getHandle(), this
+     *  normally takes no lock.
      *
      *  @requirement PM003
      *
@@ -251,6 +483,34 @@ namespace AeroKernel::Parameter
      *	@return bool
      */
     bool isRegistered( const std::string_view &key );
+    bool isRegistered( const Key &key );
+
+    /**
+     *  Looks up the handle of a registered parameter so that future accesses
+     *  can bypass the key lookup entirely.
+     *
+     *  Lookups search an immutable copy of the index published by the Manager
+     *  and take no lock, so a high priority task is never held up behind a
+     *  lower priority one that is registering. Every change to the registry
+     *  publishes a new copy in place of the old one, which is freed after
+     *  every lookup that could still be reading it has finished. Copies share
+     *  the bulk of the index, so a burst of registrations stays cheap.
+     *
+     *	@param[in]	key             The parameter's name
+     *	@return Handle              Evaluates to false if the parameter is not registered
+     */
+    Handle getHandle( const std::string_view &key );
+    Handle getHandle( const Key &key );
+
+    /**
+     *  Gets the canonical key of a registered parameter. The Manager keeps its
+     *  own copy of every registered name, and lookups using the canonical key
+     *  compare names by pointer rather than character by character.
+     *
+     *	@param[in]	handle          The parameter's handle
+     *	@return Key                 An empty key if the handle is not valid
+     */
+    Key getKey( const Handle handle );
 
     /**
      *  Read the parameter data from wherever it has been stored
@@ -262,6 +522,8 @@ namespace AeroKernel::Parameter
      *	@return bool
      */
     bool read( const std::string_view &key, void *const param );
+    bool read( const Key &key, void *const param );
+    bool read( const Handle handle, void *const param );
 
     /**
      *  Write the parameter data to wherever it is stored
@@ -273,6 +535,203 @@ namespace AeroKernel::Parameter
      *	@return bool
      */
     bool write( const std::string_view &key, const void *const param );
+    bool write( const Key &key, const void *const param );
+    bool write( const Handle handle, const void *const param );
+
+    /**
+     *  Reads a batch of parameters while taking the manager lock only once.
+     *  Requests are grouped by storage device and sorted by address, and
+     *  parameters that sit next to each other in memory are fetched with a
+     *  single driver transaction.
+     *
+     *  @requirement PM004
+     *
+     *	@param[in]	keys            The parameters' names
+     *	@param[in]	params          Where to place each parameter's data, indexed like keys
+     *	@param[in]	count           Number of parameters in the batch
+     *	@return bool                True only if every parameter was read
+     */
+    bool readMany( const Key *const keys, void *const *const params, const size_t count );
+    bool readMany( const Handle *const handles, void *const *const params, const size_t count );
+
+    /**
+     *  Writes a batch of parameters while taking the manager lock only once.
+     *  Requests are grouped by storage device and sorted by address, and
+     *  parameters that sit next to each other in memory are stored with a
+     *  single driver transaction.
+     *
+     *  @requirement PM005
+     *
+     *	@param[in]	keys            The parameters' names
+     *	@param[in]	params          Where to write each parameter's data from, indexed like keys
+     *	@param[in]	count           Number of parameters in the batch
+     *	@return bool                True only if every parameter was written
+     */
+    bool writeMany( const Key *const keys, const void *const *const params, const size_t count );
+    bool writeMany( const Handle *const handles, const void *const *const params, const size_t count );
+
+    /**
+     *  Prepares the asynchronous I/O queues, one per storage device, dropping
+     *  any requests still pending. On hosted builds a worker thread is started
+     *  for every queue. On embedded targets the application must call
+     *  serviceAsync() from a task for each storage device it uses.
+     *
+     *	@param[in]	queueDepth      Maximum number of pending requests per storage device
+     *	@return bool
+     */
+    bool enableAsync( const size_t queueDepth );
+
+    /**
+     *  Stops the asynchronous I/O workers. Requests that were never serviced
+     *  complete with a failure.
+     *
+     *	@return void
+     */
+    void disableAsync();
+
+    /**
+     *  Queues a read on the queue of the parameter's storage device and returns
+     *  immediately. The buffer must stay valid until the callback runs.
+     *
+     *  @requirement PM004
+     *
+     *	@param[in]	handle          The parameter's handle
+     *	@param[in]	param           Where to place the read data
+     *	@param[in]	callback        Invoked when the read completes, may be empty
+     *	@return bool                False if the request could not be queued
+     */
+    bool readAsync( const Handle handle, void *const param, AsyncCallback_t callback );
+    bool readAsync( const Key &key, void *const param, AsyncCallback_t callback );
+
+    /**
+     *  Queues a write on the queue of the parameter's storage device and returns
+     *  immediately. The data is not copied, so the buffer must stay valid and
+     *  unchanged until the callback runs.
+     *
+     *  @requirement PM005
+     *
+     *	@param[in]	handle          The parameter's handle
+     *	@param[in]	param           Where to write data from
+     *	@param[in]	callback        Invoked when the write completes, may be empty
+     *	@return bool                False if the request could not be queued
+     */
+    bool writeAsync( const Handle handle, const void *const param, AsyncCallback_t callback );
+    bool writeAsync( const Key &key, const void *const param, AsyncCallback_t callback );
+
+#if defined( AERO_KERNEL_PARAMETER_ASYNC_THREADS )
+    /**
+     *  Future based variants of readAsync()/writeAsync(). The future holds the
+     *  outcome of the transfer, and is ready immediately if it could not be queued.
+     */
+    std::future<bool> readAsync( const Handle handle, void *const param );
+    std::future<bool> writeAsync( const Handle handle, const void *const param );
+#endif
+
+    /**
+     *  Performs queued asynchronous requests for a storage device in the
+     *  calling context, invoking their callbacks.
+     *
+     *	@param[in]	storage         The storage device whose queue to service
+     *	@param[in]	maxRequests     Upper bound on the requests to perform
+     *	@return size_t              Number of requests performed
+     */
+    size_t serviceAsync( const StorageType storage, const size_t maxRequests = std::numeric_limits<size_t>::max() );
+
+    /**
+     *  Type safe parameter read. The size of T must exactly match the size the
+     *  parameter was registered with. Small values stored in INTERNAL_SRAM with
+     *  a registered direct access mapping are loaded straight from memory
+     *  instead of going through the memory driver.
+     *
+     *  @requirement PM004
+     *
+     *	@param[in]	key             The parameter's name
+     *	@param[out]	value           Where to place the read data
+     *	@return bool
+     */
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool read( const Key &key, T &value )
+    {
+      static_assert( std::is_trivially_copyable_v<T>, "Parameters are transferred as raw bytes" );
+      bool result = false;
+      RegistryLock lock;
+
+      if ( initialized && lockRegistry( key, lock ) )
+      {
+        result = readTyped( findSlot( key ), value, lock );
+      }
+
+      return result;
+    }
+
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool read( const std::string_view &key, T &value )
+    {
+      return read( Key( key ), value );
+    }
+
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool read( const Handle handle, T &value )
+    {
+      static_assert( std::is_trivially_copyable_v<T>, "Parameters are transferred as raw bytes" );
+      bool result = false;
+      RegistryLock lock;
+
+      if ( initialized && lockRegistry( handle, lock ) )
+      {
+        result = readTyped( isActive( handle ) ? handle.slot : INVALID_SLOT, value, lock );
+      }
+
+      return result;
+    }
+
+    /**
+     *  Type safe parameter write. The size of T must exactly match the size the
+     *  parameter was registered with. Small values stored in INTERNAL_SRAM with
+     *  a registered direct access mapping are stored straight to memory instead
+     *  of going through the memory driver.
+     *
+     *  @requirement PM005
+     *
+     *	@param[in]	key             The parameter's name
+     *	@param[in]	value           The data to write
+     *	@return bool
+     */
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool write( const Key &key, const T &value )
+    {
+      static_assert( std::is_trivially_copyable_v<T>, "Parameters are transferred as raw bytes" );
+      bool result = false;
+      RegistryLock lock;
+
+      if ( initialized && lockRegistry( key, lock ) )
+      {
+        result = writeTyped( findSlot( key ), value, lock );
+      }
+
+      return result;
+    }
+
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool write( const std::string_view &key, const T &value )
+    {
+      return write( Key( key ), value );
+    }
+
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool write( const Handle handle, const T &value )
+    {
+      static_assert( std::is_trivially_copyable_v<T>, "Parameters are transferred as raw bytes" );
+      bool result = false;
+      RegistryLock lock;
+
+      if ( initialized && lockRegistry( handle, lock ) )
+      {
+        result = writeTyped( isActive( handle ) ? handle.slot : INVALID_SLOT, value, lock );
+      }
+
+      return result;
+    }
 
     /**
      *  If registered, executes the parameter's update method
@@ -283,6 +742,7 @@ namespace AeroKernel::Parameter
      *	@return bool
      */
     bool update( const std::string_view &key );
+    bool update( const Key &key );
 
     /**
      *  Registers a memory sink with the manager backend
@@ -291,14 +751,17 @@ namespace AeroKernel::Parameter
      *
      *	@param[in]	storage         The type of storage the driver represents as defined in the Location namespace
      *	@param[in]	driver          A fully configured instance of a memory driver
-     *	@return bool
+     *	@return bool                False if the storage was bound at compile time by a StaticManager
      */
     bool registerMemoryDriver( const StorageType storage, Chimera::Modules::Memory::Device_sPtr &driver );
 
     /**
      *  Allows the user to assign virtual memory specifications to a
      *  registered memory driver. This allows for partitioning the regions
-     *  that the Parameter manager is allowed access to.
+     *  that the Parameter manager is allowed access to. Register the specs
+     *  before any parameter that relies on the Manager to pick its address.
+     *  Replacing the specs later keeps the addresses of parameters already
+     *  placed in the region, and the Manager never hands them out again.
      *
      *  @requirement PM009
      *
@@ -308,6 +771,157 @@ namespace AeroKernel::Parameter
      */
     bool registerMemorySpecs( const StorageType storage, const Chimera::Modules::Memory::Descriptor &specs );
 
+    /**
+     *  Declares that a storage region is directly addressable by the CPU, such as
+     *  SRAM or memory mapped flash. Parameters on that storage can then be
+     *  accessed in place with view(), and small typed accesses to INTERNAL_SRAM
+     *  bypass the memory driver. Parameter addresses on that storage are treated
+     *  as offsets from the given base, so the mapping must cover the same
+     *  memory the registered driver accesses.
+     *
+     *	@param[in]	storage         The type of storage being mapped
+     *	@param[in]	baseAddress     CPU address of the storage's address zero, nullptr to remove
+     *	@return bool
+     */
+    bool registerDirectAccess( const StorageType storage, void *const baseAddress );
+
+    /**
+     *  Gets a pointer straight into the storage holding a parameter, avoiding
+     *  any copy. Only parameters on storage registered with registerDirectAccess()
+     *  can be viewed, which suits large read only data such as calibration
+     *  tables. Pending cached writes to the parameter are flushed first. The
+     *  view does not lock anything, so it is up to the user to not write the
+     *  parameter while the view is in use.
+     *
+     *  @requirement PM004
+     *
+     *	@param[in]	key             The parameter's name
+     *	@return View                Evaluates to false if the parameter is not memory mapped
+     */
+    View view( const std::string_view &key );
+    View view( const Key &key );
+    View view( const Handle handle );
+
+    /**
+     *  Gets the mailbox of a parameter registered with ControlBlockFactory::setMailbox().
+     *  Publishing and fetching through the mailbox directly skips the registry
+     *  altogether, so a high rate producer and its consumers never touch the
+     *  manager lock. The mailbox remains valid until the parameter is
+     *  unregistered or the Manager is initialized again.
+     *
+     *	@param[in]	key             The parameter's name
+     *	@return Mailbox *           nullptr if the parameter isn't a mailbox
+     */
+    Mailbox *mailbox( const std::string_view &key );
+    Mailbox *mailbox( const Key &key );
+    Mailbox *mailbox( const Handle handle );
+
+    /**
+     *  Switches a storage device over to log structured storage. Every write
+     *  appends a new record to a circular log kept in the region given to
+     *  registerMemorySpecs() rather than rewriting the parameter in place, so
+     *  updates cost a page program instead of a sector erase and wear is spread
+     *  across the whole region. Parameters are found by their full name and the
+     *  address in their control block is ignored, so names are limited to
+     *  LogStore::MAX_RECORD_NAME characters. The region is scanned to recover
+     *  the latest values, and is formatted if it holds no valid log.
+     *
+     *  The driver and memory specs must already be registered. Log structured
+     *  storage is removed by init().
+     *
+     *	@param[in]	storage         The storage device to convert
+     *	@return bool
+     */
+    bool enableLogStore( const StorageType storage );
+
+    /**
+     *  Performs one incremental garbage collection step on a log structured
+     *  storage device. Writes collect on their own when the log runs low on
+     *  erased sectors, but calling this from an idle task keeps the erase
+     *  latency off the write path.
+     *
+     *	@param[in]	storage         The storage device to collect
+     *	@return bool                False if there was nothing to collect
+     */
+    bool collectGarbage( const StorageType storage );
+
+    /**
+     *  Places a RAM cache in front of parameters stored in INTERNAL_FLASH or
+     *  EXTERNAL_FLASHn, unless the device is log structured. Reads that hit the cache are served from SRAM and writes
+     *  are only marked dirty until flush() is called or the line is evicted.
+     *  Any dirty data held by a previous cache is flushed first. The cache is
+     *  removed by init(), so enable it after initializing the Manager.
+     *
+     *	@param[in]	config          Cache dimensions and eviction policy, zero lines disables the cache
+     *	@return bool
+     */
+    bool enableCache( const CacheConfig &config );
+
+    /**
+     *  Writes every dirty cache line back to its storage driver. Intended to be
+     *  called periodically from a low priority task, as well as before power
+     *  down or any other time the flash contents must be up to date. This is
+     *  the same as persistDirty().
+     *
+     *	@return bool                True if every dirty line was written back
+     */
+    bool flush();
+
+    /**
+     *  Writes back only the parameters written since they were last persisted.
+     *  Pending writes are found through a bitmap indexed by slot rather than a
+     *  scan of the registry, and are issued in address order with adjacent
+     *  parameters merged into a single driver transaction. Only writes held by
+     *  the cache are ever pending; without one, writes reach their storage
+     *  immediately and there is nothing to persist.
+     *
+     *	@return bool                True if every pending write reached its storage
+     */
+    bool persistDirty();
+
+    /**
+     *  Checks if a parameter has a write that has not yet been persisted
+     *
+     *	@param[in]	handle          The parameter's handle
+     *	@return bool
+     */
+    bool isDirty( const Handle handle );
+
+    /**
+     *  Starts counting accesses to every parameter and sets the policy used by
+     *  rebalanceTiers(). Hot parameters on EXTERNAL_FLASHn or EXTERNAL_SRAMn
+     *  are moved into space allocated from the region given to
+     *  registerMemorySpecs() for INTERNAL_SRAM, whose driver must also be
+     *  registered. The move is transparent: keys and handles keep working and
+     *  the control block reports the storage the parameter is served from.
+     *  Writes to a parameter promoted from flash are written through to
+     *  flash, so its home always holds the latest value. Tiering cannot be
+     *  changed while the registry is frozen.
+     *
+     *	@param[in]	config          Tiering policy, a zero maxPromoted demotes everything and stops counting
+     *	@return bool
+     */
+    bool enableTiering( const TieringConfig &config );
+
+    /**
+     *  Ages the access counts, then demotes promoted parameters that went cold
+     *  and promotes the hottest eligible parameters while the tier has room.
+     *  Intended to be called periodically from a low priority task. Placement
+     *  is part of what a frozen registry locks in, so nothing moves while frozen.
+     *
+     *	@return size_t              Number of parameters moved
+     */
+    size_t rebalanceTiers();
+
+    /**
+     *  Gets the access statistics of a parameter. Tiering must be enabled.
+     *
+     *	@param[in]	handle          The parameter's handle
+     *	@param[out]	stats           Where to place the statistics
+     *	@return bool
+     */
+    bool getAccessStats( const Handle handle, AccessStats &stats );
+
     /**
      *  Gets the control block associated with a given parameter
      *
@@ -317,13 +931,888 @@ namespace AeroKernel::Parameter
      *	@return const AeroKernel::Parameter::ParamCtrlBlk &
      */
     const ControlBlock &getControlBlock( const std::string_view &key );
+    const ControlBlock &getControlBlock( const Key &key );
 
-  protected:
-    bool initialized;
-    size_t lockTimeout_mS;
-    spp::sparse_hash_map<std::string_view, ControlBlock> params;
-    std::array<Chimera::Modules::Memory::Device_sPtr, static_cast<size_t>( StorageType::MAX_STORAGE_OPTIONS )> memoryDriver;
-    std::array<Chimera::Modules::Memory::Descriptor, static_cast<size_t>( StorageType::MAX_STORAGE_OPTIONS )> memorySpecs;
+    /**
+     *  Visits every registered parameter at or below a dotted namespace, ie
+     *  "nav.ekf" visits "nav.ekf.q0" and "nav.ekf.q1" but not "nav.gps.lat".
+     *  Only the parameters in the namespace are touched, regardless of how
+     *  many are registered in total. The visitor is invoked after the registry
+     *  has been released, so it may freely call back into the Manager.
+     *
+     *	@param[in]	prefix          The namespace to visit, empty for everything
+     *	@param[in]	func            Called with the canonical key and handle of each parameter
+     *	@return bool
+     */
+    bool forEachUnder( const std::string_view &prefix, const VisitCallback_t &func );
+
+    /**
+     *  Captures the values of every parameter at or below a dotted namespace
+     *  into a single self describing buffer. Each record holds the parameter
+     *  name, size and data, so the snapshot can be restored even if the
+     *  registration order has since changed. Adjacent parameters are read with
+     *  a single driver transaction.
+     *
+     *	@param[in]	prefix          The namespace to capture, empty for everything
+     *	@param[out]	buffer          Where to place the snapshot, nullptr to query the required size
+     *	@param[in]	size            Size of the buffer
+     *	@return size_t              Bytes used (or required), zero on failure
+     */
+    size_t snapshot( const std::string_view &prefix, uint8_t *const buffer, const size_t size );
+
+    /**
+     *  Writes back every parameter contained in a snapshot
+     *
+     *	@param[in]	buffer          Snapshot produced by snapshot()
+     *	@param[in]	size            Number of bytes in the snapshot
+     *	@return bool                True only if every record was restored
+     */
+    bool restore( const uint8_t *const buffer, const size_t size );
+
+    /**
+     *  Serializes the whole registry, including every parameter's name, control
+     *  block and current value, into a single versioned image on a memory
+     *  device. Loading the image at boot replaces registering and reading each
+     *  parameter individually. Update callbacks cannot be serialized and must
+     *  be attached again after loading. The image is read back once written
+     *  to confirm it landed intact.
+     *
+     *	@param[in]	device          Device to store the image on
+     *	@param[in]	address         Where on the device the image starts
+     *	@return size_t              Size of the image in bytes, zero on failure
+     */
+    size_t saveImage( Chimera::Modules::Memory::Device_sPtr &device, const size_t address );
+
+    /**
+     *  Replaces the registry with one stored by saveImage(). The image is
+     *  fetched with a single sequential read and the index is built directly
+     *  from it without allocating any addresses. Every parameter
+     *  returns to the slot it held when the image was saved, and handles from
+     *  before the load are invalidated. Values stored in volatile memory are
+     *  written back through their drivers, which must already be registered,
+     *  while non-volatile values are left as they are on their devices. The
+     *  registry is left untouched if the image is missing, corrupt, larger
+     *  than maxSize, names a parameter twice, or does not fit within the
+     *  capacity given to init().
+     *
+     *	@param[in]	device          Device holding the image
+     *	@param[in]	address         Where on the device the image starts
+     *	@param[in]	maxSize         Largest image to accept, bounding what a corrupt header can make the load allocate
+     *	@return bool                False if the image could not be loaded or a value not restored
+     */
+    bool loadImage( Chimera::Modules::Memory::Device_sPtr &device, const size_t address,
+                    const size_t maxSize = IMAGE_SIZE_LIMIT );
+
+    /**
+     *  Locks the registry into its current configuration once startup registration
+     *  is complete. A minimal perfect hash is built over the registered keys, after
+     *  which every key lookup is a single hash and compare that takes no lock.
+     *  Parameters, memory drivers, memory specs and direct access mappings can no
+     *  longer be changed until the Manager is initialized again.
+     *
+     *	@return bool                False if the perfect hash could not be built
+     */
+    bool freeze();
+
+    /**
+     *  Checks if the registry has been frozen
+     *
+     *	@return bool
+     */
+    bool isFrozen() const;
+
+    /**
+     *  Opens a transaction. Until commit() or rollback(), every parameter write
+     *  is staged in RAM instead of reaching its storage, and reads keep
+     *  returning the committed values. Transactions do not nest.
+     *
+     *	@return bool                False if a transaction is already open
+     */
+    bool beginTransaction();
+
+    /**
+     *  Applies every write staged by the open transaction. Writes to flash are
+     *  grouped by erase sector so that each affected sector is read, erased
+     *  and programmed exactly once, no matter how many parameters it holds.
+     *  Readers never observe a partially applied commit; any read that
+     *  overlaps a commit waits for it and then returns the new values.
+     *
+     *	@return bool                True if every staged write was applied
+     */
+    bool commit();
+
+    /**
+     *  Discards every write staged by the open transaction
+     *
+     *	@return bool                False if no transaction was open
+     */
+    bool rollback();
+
+  protected:
+    /**
+     *  Checks that a handle references a currently registered parameter. The
+     *  caller must have acquired the registry with lockRegistry().
+     *
+     *	@param[in]	handle          The handle to validate
+     *	@return bool
+     */
+    bool isActive( const Handle handle ) const;
+
+    /**
+     *  Gets the slot a handle references, for use by derived managers which
+     *  can't see inside a Handle. Same locking contract as isActive().
+     *
+     *	@param[in]	handle          The handle to resolve
+     *	@return uint16_t            INVALID_SLOT if the handle is stale
+     */
+    uint16_t activeSlot( const Handle handle ) const
+    {
+      return isActive( handle ) ? handle.slot : INVALID_SLOT;
+    }
+
+    /**
+     *  Index stripe held by a single parameter access
+     */
+    struct RegistryLock
+    {
+      uint8_t stripe; /**< Selected by the parameter's key hash */
+      bool held;      /**< False if the registry was frozen and nothing was locked */
+    };
+
+    /**
+     *  Gains read access to the registry for one parameter. While the registry
+     *  is mutable this takes the index stripe selected by the parameter's key
+     *  hash, so accesses to parameters on other stripes don't wait on each
+     *  other. Once frozen the registry is immutable and nothing is locked.
+     *
+     *	@param[in]	key             The parameter's name
+     *	@param[in]	handle          Alternatively, a handle to the parameter
+     *	@param[out]	lock            What was taken, pass to unlockRegistry()
+     *	@return bool                False if the lock could not be acquired
+     */
+    bool lockRegistry( const Key &key, RegistryLock &lock );
+    bool lockRegistry( const Handle handle, RegistryLock &lock );
+    void unlockRegistry( const RegistryLock &lock );
+
+    /**
+     *  Gains exclusive access to the registry by taking every index stripe and
+     *  then the manager lock. Anything that changes the registry must hold
+     *  this, which lets bulk operations read it while holding only the manager
+     *  lock and single parameter accesses while holding only their stripe.
+     *
+     *	@return bool                False if the locks could not be acquired
+     */
+    bool lockExclusive();
+    void unlockExclusive();
+
+    /**
+     *  Serializes calls into the driver of one storage type, so a slow device
+     *  only holds up transfers to itself. Held only around the driver calls
+     *  and never while acquiring any other lock.
+     *
+     *	@param[in]	storage         The storage type whose driver is about to be used
+     *	@return bool                False if the lock could not be acquired
+     */
+    bool lockDriver( const StorageType storage );
+    void unlockDriver( const StorageType storage );
+
+    /**
+     *  Resolves a key to its control block slot using a single map probe, or
+     *  the perfect hash if the registry is frozen. The caller must have
+     *  acquired the registry with lockRegistry().
+     *
+     *	@param[in]	key             The parameter's name
+     *	@return uint16_t            The slot index, or INVALID_SLOT if not registered
+     */
+    uint16_t findSlot( const Key &key ) const;
+
+    /**
+     *  Transfers a parameter between its storage driver and the user's buffer.
+     *  The caller must have acquired the registry with lockRegistry(), which is
+     *  released once the control block has been inspected and before the driver
+     *  is accessed.
+     *
+     *	@param[in]	slot            Control block slot, INVALID_SLOT fails the transfer
+     *	@param[in]	param           User buffer to read into or write from
+     *	@param[in]	expectedSize    If non-zero, the transfer fails unless the parameter is this size
+     *	@param[in]	lock            The lock taken by lockRegistry()
+     *	@return bool
+     */
+    bool readSlot( const uint16_t slot, void *const param, const size_t expectedSize, const RegistryLock &lock );
+    bool writeSlot( const uint16_t slot, const void *const param, const size_t expectedSize, const RegistryLock &lock );
+
+    /**
+     *  Gets the CPU address of a parameter that may be accessed directly with a
+     *  load or store. The caller must have acquired the registry with lockRegistry().
+     *
+     *	@param[in]	slot            Control block slot
+     *	@param[in]	size            Size of the access, which must match the parameter size
+     *	@param[in]	write           True for a store, which promoted parameters can't take directly
+     *	@return uint8_t *           nullptr if the parameter must go through its driver
+     */
+    uint8_t *directAddress( const uint16_t slot, const size_t size, const bool write ) const;
+
+    /**
+     *  Records an access for tiering. The caller must have acquired the
+     *  registry with lockRegistry().
+     *
+     *	@param[in]	slot            Control block slot, INVALID_SLOT is ignored
+     *	@param[in]	write           True for a write, false for a read
+     *	@return void
+     */
+    void countAccess( const uint16_t slot, const bool write )
+    {
+      if ( accessCounts && ( slot != INVALID_SLOT ) )
+      {
+        accessCounts[ ( slot * 2u ) + ( write ? 1u : 0u ) ].fetch_add( 1u, std::memory_order_relaxed );
+      }
+    }
+
+    /**
+     *  Gets the mailbox backing a parameter. The caller must have acquired the
+     *  registry with lockRegistry().
+     *
+     *	@param[in]	slot            Control block slot
+     *	@return Mailbox *           nullptr if the parameter isn't a mailbox
+     */
+    Mailbox *slotMailbox( const uint16_t slot ) const;
+
+    /**
+     *  Gives a newly registered mailbox parameter its buffers, reusing the
+     *  slot's previous mailbox if the size matches. A replaced mailbox is kept
+     *  until the next init(), as a consumer may still be holding it. The
+     *  caller must hold the manager lock.
+     *
+     *	@param[in]	slot            Control block slot
+     *	@return void
+     */
+    void attachMailbox( const uint16_t slot );
+
+    /**
+     *  Publishes or fetches a batch member that is a mailbox. The caller must
+     *  hold the manager lock.
+     *
+     *	@param[in]	slot            Control block slot
+     *	@param[in]	readBuffer      Destination when reading, otherwise nullptr
+     *	@param[in]	writeBuffer     Source when writing, otherwise nullptr
+     *	@return bool                False if the parameter isn't a mailbox
+     */
+    bool transferMailbox( const uint16_t slot, void *const readBuffer, const void *const writeBuffer );
+
+    /**
+     *  Checks if a parameter has its own sequence counter. The caller must
+     *  have acquired the registry with lockRegistry().
+     *
+     *	@param[in]	slot            Control block slot, INVALID_SLOT is never sequenced
+     *	@return bool
+     */
+    bool isSequenced( const uint16_t slot ) const
+    {
+      return ( slot != INVALID_SLOT ) && ControlBlockInterpreter::isSequenced( controlBlocks[ slot ] );
+    }
+
+    /**
+     *  Per parameter counterpart of readBegin()/readValidate(). A write holds
+     *  the count odd while it runs, so a read must be repeated if the count
+     *  was odd when it started or changed before it finished. Takes no lock
+     *  and never holds up the writer.
+     *
+     *	@param[in]	slot            Control block slot of a sequence counted parameter
+     *	@param[in]	sequence        Value returned by slotReadBegin()
+     *	@return uint32_t / bool
+     */
+    uint32_t slotReadBegin( const uint16_t slot ) const
+    {
+      return sequences[ slot ].load( std::memory_order_acquire );
+    }
+
+    bool slotReadValidate( const uint16_t slot, const uint32_t sequence ) const
+    {
+      std::atomic_thread_fence( std::memory_order_acquire );
+      return !( sequence & 1u ) && ( sequences[ slot ].load( std::memory_order_relaxed ) == sequence );
+    }
+
+    /**
+     *  Brackets every transfer that stores to a sequence counted parameter
+     *
+     *	@param[in]	slot            Control block slot of a sequence counted parameter
+     *	@return void
+     */
+    void slotWriteBegin( const uint16_t slot )
+    {
+      sequences[ slot ].fetch_add( 1u, std::memory_order_relaxed );
+      std::atomic_thread_fence( std::memory_order_release );
+    }
+
+    void slotWriteEnd( const uint16_t slot )
+    {
+      sequences[ slot ].fetch_add( 1u, std::memory_order_release );
+    }
+
+    /**
+     *  Gets the CPU address of a parameter on any memory mapped storage. The
+     *  caller must have acquired the registry with lockRegistry().
+     *
+     *	@param[in]	slot            Control block slot
+     *	@return uint8_t *           nullptr if the storage is not memory mapped
+     */
+    uint8_t *mappedAddress( const uint16_t slot ) const;
+
+    /**
+     *  Resolves a view of a slot. Follows the same registry locking contract
+     *  as readSlot().
+     */
+    View viewSlot( const uint16_t slot, const RegistryLock &lock );
+
+    /**
+     *  Typed transfer backing the read<T>/write<T> templates. Follows the same
+     *  registry locking contract as readSlot/writeSlot.
+     */
+    template<typename T>
+    bool readTyped( const uint16_t slot, T &value, const RegistryLock &lock )
+    {
+      bool result     = false;
+      uint8_t *direct = nullptr;
+
+      if constexpr ( sizeof( T ) <= DIRECT_ACCESS_LIMIT )
+      {
+        direct = directAddress( slot, sizeof( T ), false );
+      }
+
+      if ( direct )
+      {
+        uint32_t sequence    = 0;
+        uint32_t version     = 0;
+        const bool sequenced = isSequenced( slot );
+        countAccess( slot, false );
+
+        do
+        {
+          sequence = readBegin();
+          version  = sequenced ? slotReadBegin( slot ) : 0u;
+          memcpy( &value, direct, sizeof( T ) );
+        } while ( !readValidate( sequence ) || ( sequenced && !slotReadValidate( slot, version ) ) );
+
+        unlockRegistry( lock );
+        result = true;
+      }
+      else
+      {
+        result = readSlot( slot, &value, sizeof( T ), lock );
+      }
+
+      return result;
+    }
+
+    template<typename T>
+    bool writeTyped( const uint16_t slot, const T &value, const RegistryLock &lock )
+    {
+      bool result     = false;
+      uint8_t *direct = nullptr;
+
+      if constexpr ( sizeof( T ) <= DIRECT_ACCESS_LIMIT )
+      {
+        /* Transactions must stage every write, so skip the shortcut */
+        if ( !transactionOpen.load( std::memory_order_acquire ) )
+        {
+          direct = directAddress( slot, sizeof( T ), true );
+        }
+      }
+
+      if ( direct )
+      {
+        const bool sequenced = isSequenced( slot );
+        countAccess( slot, true );
+
+        if ( sequenced )
+        {
+          slotWriteBegin( slot );
+        }
+
+        memcpy( direct, &value, sizeof( T ) );
+
+        if ( sequenced )
+        {
+          slotWriteEnd( slot );
+        }
+
+        unlockRegistry( lock );
+        result = true;
+      }
+      else
+      {
+        result = writeSlot( slot, &value, sizeof( T ), lock );
+      }
+
+      return result;
+    }
+
+    /**
+     *  Starts a read that must not overlap a commit. If a commit is in progress,
+     *  this waits for it by briefly taking the manager lock, which the commit
+     *  holds for its duration. The caller must not hold the manager lock
+     *  unless it knows no commit can be running.
+     *
+     *	@return uint32_t            Commit sequence to pass to readValidate()
+     */
+    uint32_t readBegin();
+
+    /**
+     *  Checks that no commit started or finished since readBegin()
+     *
+     *	@param[in]	sequence        Value returned by readBegin()
+     *	@return bool                False if the read must be repeated
+     */
+    bool readValidate( const uint32_t sequence ) const;
+
+    /**
+     *  Stages a write in the open transaction, replacing any earlier staged
+     *  write to the same parameter. The caller must have acquired the registry,
+     *  which is left held.
+     *
+     *	@param[in]	slot            Control block slot, INVALID_SLOT fails the write
+     *	@param[in]	param           Data to stage
+     *	@param[in]	expectedSize    If non-zero, the write fails unless the parameter is this size
+     *	@param[in]	locked          True if the caller already holds the manager lock
+     *	@param[out]	result          Outcome of the write, only valid if it was staged
+     *	@return bool                False if no transaction is open
+     */
+    bool stageWrite( const uint16_t slot, const void *const param, const size_t expectedSize, const bool locked,
+                     bool &result );
+
+    /**
+     *  Writes the staged data to storage. The caller must hold the manager lock.
+     *
+     *	@return bool
+     */
+    bool applyStaged();
+
+    /**
+     *  A queued asynchronous transfer. Exactly one of the buffers is set.
+     */
+    struct AsyncRequest
+    {
+      Handle handle;
+      void *readBuffer        = nullptr;
+      const void *writeBuffer = nullptr;
+      AsyncCallback_t callback;
+    };
+
+    /**
+     *  Places a request on the queue of the parameter's storage device
+     *
+     *	@param[in]	request         The request to queue
+     *	@return bool
+     */
+    bool queueAsync( AsyncRequest &&request );
+
+    /**
+     *  Settles the address of a parameter being registered. Unset addresses are
+     *  allocated from the storage's region and user chosen addresses are
+     *  reserved so that they are never handed out. The caller must hold the
+     *  manager lock.
+     *
+     *	@param[in]	current         Control block the slot holds now
+     *	@param[in]	block           Control block being registered, updated with the placement
+     *	@return bool                False if no address could be allocated
+     */
+    bool placeParameter( const ControlBlock &current, ControlBlock &block );
+
+    /**
+     *  Reserves or returns the memory occupied by a parameter in its storage's
+     *  address allocator. The caller must hold the manager lock.
+     *
+     *	@param[in]	block           The parameter's control block
+     *	@param[in]	used            True to reserve the memory, false to return it
+     *	@return void
+     */
+    void accountPlacement( const ControlBlock &block, const bool used );
+
+    /**
+     *  Checks if parameters on a storage device are eligible for caching
+     *
+     *	@param[in]	storage         The storage device
+     *	@return bool
+     */
+    bool isCacheable( const StorageType storage ) const;
+
+    /**
+     *  Registers a driver that can't be replaced until the next init(), so the
+     *  Manager may hold on to it without taking a reference
+     *
+     *	@param[in]	storage         The type of storage the driver represents
+     *	@param[in]	driver          The driver, which must outlive the Manager
+     *	@return bool
+     */
+    bool bindMemoryDriver( const StorageType storage, Chimera::Modules::Memory::Device_sPtr &driver );
+
+    /**
+     *  Checks if a typed access can go straight to a driver bound with
+     *  bindMemoryDriver(), as nothing the Manager layers over the driver (log
+     *  stores, the cache, transactions or tiering) applies to it. The caller
+     *  must have acquired the registry with lockRegistry().
+     *
+     *	@param[in]	slot            Control block slot
+     *	@param[in]	size            Size of the access, which must match the parameter size
+     *	@param[in]	write           True for a store
+     *	@param[out]	address         The parameter's address on the storage
+     *	@return StorageType         StorageType::NONE if the access must take the general path
+     */
+    StorageType plainAccess( const uint16_t slot, const size_t size, const bool write, size_t &address ) const;
+
+    /**
+     *  Transfers a parameter through the cache. Follows no registry locking
+     *  contract, as the target describes everything needed for the transfer.
+     *
+     *	@param[in]	target          Slot, storage, address and size of the parameter
+     *	@param[in]	param           User buffer to read into or write from
+     *	@param[out]	result          Outcome of the transfer, only valid if the cache handled it
+     *	@return bool                False if the parameter must go straight to its driver
+     */
+    bool cacheRead( const Cache::Line &target, void *const param, bool &result );
+    bool cacheWrite( const Cache::Line &target, const void *const param, bool &result );
+
+    /**
+     *  Finds the line caching a target parameter, replacing a line that holds a
+     *  stale copy of the slot, or claims a victim line for it. The caller must
+     *  hold the cache lock.
+     *
+     *	@param[in]	target          Slot, storage, address and size of the parameter
+     *	@param[out]	hit             Set if the returned line already holds the parameter
+     *	@return Cache::Line *       nullptr if no line is available
+     */
+    Cache::Line *cacheLine( const Cache::Line &target, bool &hit );
+
+    /**
+     *  Writes a dirty cache line back to its storage driver. The caller must
+     *  hold the cache lock.
+     *
+     *	@param[in]	line            The line to write back
+     *	@return bool
+     */
+    bool writeBack( Cache::Line &line );
+
+    /**
+     *  Writes back and removes a slot from the cache, if present. Used whenever
+     *  the slot's control block changes. The caller must hold the cache lock.
+     *
+     *	@param[in]	slot            Control block slot
+     *	@return void
+     */
+    void evictSlot( const uint16_t slot );
+
+    /**
+     *  Writes back every dirty cache line in address order, merging adjacent
+     *  lines into single transactions. The caller must hold the cache lock.
+     *
+     *	@return bool                True if every dirty line was written back
+     */
+    bool writeBackDirty();
+
+    /**
+     *  Moves a parameter into the INTERNAL_SRAM tier, or back to its home. The
+     *  caller must hold the manager lock.
+     *
+     *	@param[in]	slot            Control block slot
+     *	@return bool                False if the parameter was left where it was
+     */
+    bool promoteSlot( const uint16_t slot );
+    bool demoteSlot( const uint16_t slot );
+
+    /**
+     *  Gets the control block a parameter was registered with, which differs
+     *  from the current one while it is promoted. The caller must have
+     *  acquired the registry with lockRegistry().
+     *
+     *	@param[in]	slot            Control block slot
+     *	@return const ControlBlock &
+     */
+    const ControlBlock &homeBlock( const uint16_t slot ) const;
+
+    /**
+     *  Copies a freshly written value of a promoted parameter to its flash
+     *  home. Does nothing for other parameters. The caller must hold the
+     *  manager lock.
+     *
+     *	@param[in]	slot            Control block slot
+     *	@param[in]	param           The value just written
+     *	@return bool
+     */
+    bool writeThrough( const uint16_t slot, const void *const param );
+
+    /**
+     *  Transfers a parameter straight to or from the storage its control
+     *  block names, going through the log store if there is one but never
+     *  through the cache. Follows no registry locking contract.
+     *
+     *	@param[in]	block           Where the parameter lives
+     *	@param[in]	key             The parameter's key, used by log stores
+     *	@param[in]	param           User buffer to read into or write from
+     *	@return bool
+     */
+    bool readStorage( const ControlBlock &block, const Key &key, void *const param );
+    bool writeStorage( const ControlBlock &block, const Key &key, const void *const param );
+
+    /**
+     *  Writes through a driver and log store the caller resolved earlier, for
+     *  callers that no longer hold the lock protecting the storage tables
+     *
+     *	@param[in]	block           Where the parameter lives
+     *	@param[in]	key             The parameter's key, used by log stores
+     *	@param[in]	param           User buffer to write from
+     *	@param[in]	driver          Driver of the block's storage
+     *	@param[in]	log             Log store of the block's storage, if it has one
+     *	@return bool
+     */
+    bool writeStorage( const ControlBlock &block, const Key &key, const void *const param,
+                       Chimera::Modules::Memory::Device *const driver, LogStore *const log );
+
+    /**
+     *  Immutable view of the key index read by lock free lookups. The base is
+     *  shared between versions and only rebuilt every INDEX_RECENT_LIMIT
+     *  changes. The changes made since are listed on top of it.
+     */
+    struct IndexVersion
+    {
+      std::shared_ptr<const FlatMap> base;
+      std::vector<std::pair<Key, uint16_t>> recent; /**< Newest last, INVALID_SLOT marks a removal */
+      std::vector<uint16_t> generations;
+      uint8_t drained = 0; /**< Reader parities seen idle since the version was retired */
+    };
+
+    /**
+     *  Looks a key up in the published index without taking any lock
+     *
+     *	@param[in]	key             The parameter's name
+     *	@param[out]	handle          The parameter's handle, invalid if not registered
+     *	@return bool                False if no index is published and the caller must take the lock
+     */
+    bool findPublished( const Key &key, Handle &handle );
+
+    /**
+     *  Rebuilds the base of the index from the registry and publishes it,
+     *  retiring the previous version. The caller must hold the manager lock.
+     *
+     *	@return void
+     */
+    void publishIndex();
+
+    /**
+     *  Publishes a version of the index that includes one change to the
+     *  registry, rebuilding the base once enough changes have piled up. The
+     *  caller must hold the manager lock.
+     *
+     *	@param[in]	key             The interned key that changed
+     *	@param[in]	slot            Slot the key now resolves to, INVALID_SLOT if it was removed
+     *	@return void
+     */
+    void publishChange( const Key &key, const uint16_t slot );
+
+    /**
+     *  Publishes the current base and recent changes as a new version. The
+     *  caller must hold the manager lock.
+     *
+     *	@return void
+     */
+    void installIndex();
+
+    /**
+     *  Withdraws the published index while the registry is rebuilt, sending
+     *  lookups through the lock until publishIndex() is called again. The
+     *  caller must hold the manager lock.
+     *
+     *	@return void
+     */
+    void retireIndex();
+
+    /**
+     *  Frees retired index copies once both reader parities have been seen
+     *  idle since they were retired, then advances the reader epoch so a busy
+     *  parity gets the chance to drain. The caller must hold the manager lock.
+     *
+     *	@return void
+     */
+    void reclaimIndexes();
+
+    /**
+     *  Per slot tiering bookkeeping
+     */
+    struct TierState
+    {
+      ControlBlock home; /**< Registered control block, valid while promoted */
+      uint32_t heat;     /**< Aged access count */
+      uint32_t seen;     /**< Total accesses when last aged */
+    };
+
+    static constexpr size_t DIRECT_ACCESS_LIMIT = 8;   /**< Largest typed access eligible for direct load/store */
+    static constexpr size_t BATCH_BUFFER_SIZE   = 256; /**< Largest coalesced batch transaction */
+    static constexpr size_t INDEX_STRIPES       = 8;   /**< Registry locks shared out by key hash */
+    static constexpr size_t INDEX_RECENT_LIMIT  = 32;  /**< Changes listed on top of a published index before it is rebuilt */
+
+    /**
+     *  Header preceding each parameter in a snapshot. The name follows the
+     *  header and the data follows the name, each padded to SNAPSHOT_ALIGNMENT.
+     */
+    struct SnapshotRecord
+    {
+      uint32_t nameLength;
+      uint32_t size;
+    };
+
+    static constexpr size_t SNAPSHOT_ALIGNMENT = 4;
+
+    /**
+     *  Leads a registry image. The entry table follows the header, then the
+     *  blob of names, then the blob of values, each padded to IMAGE_ALIGNMENT.
+     *  The checksum covers everything after the header.
+     */
+    struct ImageHeader
+    {
+      uint32_t magic;
+      uint16_t version;
+      uint16_t entrySize; /**< sizeof( ImageEntry ) when the image was saved */
+      uint32_t entryCount;
+      uint32_t namesSize;
+      uint32_t valuesSize;
+      uint32_t totalSize; /**< Header included */
+      uint32_t checksum;
+      uint32_t reserved;
+    };
+
+    /**
+     *  Describes one parameter in a registry image. Offsets are relative to
+     *  the start of the names and values blobs.
+     */
+    struct ImageEntry
+    {
+      uint32_t hash;
+      uint32_t nameOffset;
+      uint16_t nameLength;
+      uint16_t slot;        /**< Slot the parameter occupied when saved */
+      uint32_t valueOffset; /**< IMAGE_NO_VALUE if the value could not be captured */
+      uint32_t address;     /**< Encoded ControlBlock fields. Callbacks are never saved. */
+      uint32_t size;
+      uint32_t config;
+      uint32_t reserved;
+    };
+
+    static_assert( sizeof( ImageHeader ) == 32, "Registry image header layout changed" );
+    static_assert( sizeof( ImageEntry ) == 32, "Registry image entry layout changed" );
+
+    static constexpr uint32_t IMAGE_MAGIC    = 0x4B505241; /**< "ARPK" when stored little endian */
+    static constexpr uint16_t IMAGE_VERSION  = 1;
+    static constexpr size_t IMAGE_ALIGNMENT  = 4;
+    static constexpr uint32_t IMAGE_NO_VALUE = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t IMAGE_SIZE_LIMIT = 1024u * 1024u; /**< Default cap on the image loadImage() will read */
+
+    /**
+     *  Computes the checksum of a registry image, covering everything after the header
+     *
+     *	@param[in]	image           The complete image
+     *	@param[in]	size            Size of the image, header included
+     *	@return uint32_t
+     */
+    static uint32_t imageChecksum( const uint8_t *const image, const size_t size );
+
+    /**
+     *  A write held back by an open transaction
+     */
+    struct StagedWrite
+    {
+      uint16_t slot;
+      uint16_t generation; /**< Detects the parameter being unregistered before commit */
+      uint32_t offset;     /**< Location of the data in stagedData */
+      uint32_t size;
+    };
+
+    /**
+     *  A single parameter transfer within a batch
+     */
+    struct BatchEntry
+    {
+      uint32_t address;
+      uint32_t size;
+      uint32_t index;    /**< Position of the request in the user's arrays */
+      uint32_t sequence; /**< Sequence count seen before reading a sequence counted parameter */
+      uint16_t slot;
+      StorageType storage;
+      bool sequenced;
+    };
+
+    /**
+     *  Adds a parameter to the pending batch. The caller must hold the manager lock.
+     *
+     *	@param[in]	slot            Control block slot of the parameter
+     *	@param[in]	index           Position of the request in the user's arrays
+     *	@return bool                False if the parameter cannot be transferred
+     */
+    bool queueBatch( const uint16_t slot, const size_t index );
+
+    /**
+     *  Executes the pending batch, coalescing adjacent transfers on the same
+     *  storage device. Exactly one of the buffer arrays must be provided. The
+     *  caller must hold the manager lock.
+     *
+     *	@param[in]	readBuffers     Destination buffers when reading
+     *	@param[in]	writeBuffers    Source buffers when writing
+     *	@return bool                True if every queued transfer succeeded
+     */
+    bool executeBatch( void *const *const readBuffers, const void *const *const writeBuffers );
+
+    bool initialized;
+    std::atomic<bool> frozen;
+    std::atomic<bool> transactionOpen;
+    std::atomic<uint32_t> commitSequence;
+    size_t lockTimeout_mS;
+    IndexMap params;
+    std::vector<ControlBlock> controlBlocks;
+    std::vector<uint16_t> generations;
+    std::unique_ptr<std::atomic<uint32_t>[]> sequences;
+    std::unique_ptr<std::atomic<uint8_t>[]> slotStripes;
+    std::array<Chimera::Threading::Lockable, INDEX_STRIPES> indexStripes;
+    std::array<Chimera::Threading::Lockable, static_cast<size_t>( StorageType::MAX_STORAGE_OPTIONS )> driverLocks;
+    std::vector<std::unique_ptr<Mailbox>> mailboxes;
+    std::vector<std::unique_ptr<Mailbox>> retiredMailboxes;
+    std::vector<uint16_t> freeSlots;
+    std::vector<Key> slotKeys;
+    KeyArena keyNames;
+    KeyTree keyTree;
+    std::vector<BatchEntry> batchEntries;
+    std::vector<uint8_t> batchBuffer;
+    PerfectHash frozenIndex;
+    std::atomic<IndexVersion *> publishedIndex;
+    std::vector<std::unique_ptr<IndexVersion>> retiredIndexes;
+    std::shared_ptr<const FlatMap> indexBase;
+    std::vector<std::pair<Key, uint16_t>> indexRecent;
+    std::array<std::atomic<uint32_t>, 2> readerCounts;
+    std::atomic<uint32_t> readerEpoch;
+    Cache cache;
+    std::vector<Cache::Line *> persistOrder;
+    std::vector<uint8_t> persistBuffer;
+    TieringConfig tiering;
+    std::vector<TierState> tiers;
+    std::vector<ControlBlock> tierRetired;
+    std::vector<uint8_t> tierBuffer;
+    std::unique_ptr<std::atomic<uint32_t>[]> accessCounts;
+    std::atomic<uint32_t> tierEpoch;
+    uint16_t boundDrivers;
+    std::vector<StagedWrite> stagedWrites;
+    std::vector<uint8_t> stagedData;
+    std::vector<uint8_t> sectorBuffer;
+    std::array<std::shared_ptr<LogStore>, static_cast<size_t>( StorageType::MAX_STORAGE_OPTIONS )> logStores;
+    std::array<Chimera::Modules::Memory::Device_sPtr, static_cast<size_t>( StorageType::MAX_STORAGE_OPTIONS )> memoryDriver;
+    std::array<Chimera::Modules::Memory::Descriptor, static_cast<size_t>( StorageType::MAX_STORAGE_OPTIONS )> memorySpecs;
+    std::array<uint8_t *, static_cast<size_t>( StorageType::MAX_STORAGE_OPTIONS )> directBase;
+    std::array<AddressAllocator, static_cast<size_t>( StorageType::MAX_STORAGE_OPTIONS )> allocators;
+    std::array<AsyncQueue<AsyncRequest>, static_cast<size_t>( StorageType::MAX_STORAGE_OPTIONS )> asyncQueues;
+
+#if defined( AERO_KERNEL_PARAMETER_ASYNC_THREADS )
+    std::array<std::thread, static_cast<size_t>( StorageType::MAX_STORAGE_OPTIONS )> asyncWorkers;
+    std::array<bool, static_cast<size_t>( StorageType::MAX_STORAGE_OPTIONS )> asyncPending; /**< Queues with unserviced requests, guarded by asyncMutex */
+    std::atomic<bool> asyncRunning;
+    std::mutex asyncMutex;
+    std::condition_variable asyncSignal;
+#endif
   };
 
   using Manager_sPtr = std::shared_ptr<Manager>;
@@ -0,0 +1,209 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_alloc.cpp
+ *
+ *  Description:
+ *    Implements the Parameter Manager address allocator.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <algorithm>
+
+#include <AeroKernel/parameter_alloc.hpp>
+
+namespace AeroKernel::Parameter
+{
+  AddressAllocator::AddressAllocator() : startAddress( 0 ), pageSize( 0 ), pagesPerSector( 0 )
+  {
+    reset();
+  }
+
+  bool AddressAllocator::init( const Chimera::Modules::Memory::Descriptor &specs )
+  {
+    const size_t regionSize = ( specs.endAddress >= specs.startAddress ) ? ( specs.endAddress - specs.startAddress + 1u ) : 0u;
+
+    reset();
+
+    startAddress = specs.startAddress;
+    pageSize     = specs.pageSize ? specs.pageSize : DEFAULT_PAGE_SIZE;
+
+    /*------------------------------------------------
+    A device without erase sectors is treated as one big sector
+    ------------------------------------------------*/
+    const size_t numPages = regionSize / pageSize;
+    pagesPerSector        = ( specs.sectorSize >= pageSize ) ? ( specs.sectorSize / pageSize ) : numPages;
+
+    pageUse.assign( numPages, 0u );
+
+    return isEnabled();
+  }
+
+  void AddressAllocator::reset()
+  {
+    pageUse.clear();
+    openPages.fill( OpenPage{ NO_PAGE, 0 } );
+  }
+
+  uint32_t AddressAllocator::allocate( const size_t size, const uint8_t group )
+  {
+    uint32_t result    = INVALID_ADDRESS;
+    const size_t bytes = ( size + ALIGNMENT - 1u ) & ~( ALIGNMENT - 1u );
+    OpenPage &open     = openPages[ group % MAX_GROUPS ];
+
+    if ( !isEnabled() || !bytes )
+    {
+      return result;
+    }
+
+    if ( bytes <= pageSize )
+    {
+      /*------------------------------------------------
+      Pack into the group's open page, or open a new one next to it
+      ------------------------------------------------*/
+      if ( ( open.page == NO_PAGE ) || ( ( open.used + bytes ) > pageSize ) )
+      {
+        open = OpenPage{ findPages( 1u, open.page ), 0 };
+      }
+
+      if ( open.page != NO_PAGE )
+      {
+        result = static_cast<uint32_t>( startAddress + ( open.page * pageSize ) + open.used );
+        open.used += bytes;
+        pageUse[ open.page ]++;
+      }
+    }
+    else
+    {
+      const size_t count = ( bytes + pageSize - 1u ) / pageSize;
+      const size_t first = findPages( count, open.page );
+
+      if ( first != NO_PAGE )
+      {
+        for ( size_t page = first; page < ( first + count ); page++ )
+        {
+          pageUse[ page ]++;
+        }
+
+        result = static_cast<uint32_t>( startAddress + ( first * pageSize ) );
+      }
+    }
+
+    return result;
+  }
+
+  void AddressAllocator::claim( const size_t address, const size_t size )
+  {
+    if ( isEnabled() && size && ( address >= startAddress ) )
+    {
+      const size_t first = ( address - startAddress ) / pageSize;
+      const size_t last  = std::min( ( address - startAddress + size - 1u ) / pageSize, pageUse.size() - 1u );
+
+      for ( size_t page = first; page <= last; page++ )
+      {
+        pageUse[ page ]++;
+      }
+
+      /*------------------------------------------------
+      Move any group packing one of these pages past the claimed bytes,
+      so the next allocation from it can't overlap them
+      ------------------------------------------------*/
+      const size_t end = address - startAddress + size;
+
+      for ( auto &open : openPages )
+      {
+        if ( ( open.page != NO_PAGE ) && ( open.page >= first ) && ( open.page <= last ) )
+        {
+          const size_t claimed = std::min( end - ( open.page * pageSize ), pageSize );
+          open.used            = std::max( open.used, std::min( ( claimed + ALIGNMENT - 1u ) & ~( ALIGNMENT - 1u ), pageSize ) );
+        }
+      }
+    }
+  }
+
+  void AddressAllocator::release( const size_t address, const size_t size )
+  {
+    if ( isEnabled() && size && ( address >= startAddress ) )
+    {
+      const size_t first = ( address - startAddress ) / pageSize;
+      const size_t last  = std::min( ( address - startAddress + size - 1u ) / pageSize, pageUse.size() - 1u );
+
+      for ( size_t page = first; page <= last; page++ )
+      {
+        if ( pageUse[ page ] && ( --pageUse[ page ] == 0u ) )
+        {
+          /*------------------------------------------------
+          An empty page can be handed out again, so stop packing into it
+          ------------------------------------------------*/
+          for ( auto &open : openPages )
+          {
+            if ( open.page == page )
+            {
+              open = OpenPage{ NO_PAGE, 0 };
+            }
+          }
+        }
+      }
+    }
+  }
+
+  size_t AddressAllocator::findPages( const size_t count, const size_t near ) const
+  {
+    const size_t numPages  = pageUse.size();
+    const bool sectorBound = ( count <= pagesPerSector );
+
+    auto fits = [ & ]( const size_t first ) {
+      return ( ( first + count ) <= numPages )
+             && ( !sectorBound || ( ( first / pagesPerSector ) == ( ( first + count - 1u ) / pagesPerSector ) ) )
+             && isFree( first, count );
+    };
+
+    /*------------------------------------------------
+    First choice: the sector the group already lives in
+    ------------------------------------------------*/
+    if ( near != NO_PAGE )
+    {
+      const size_t sectorStart = ( near / pagesPerSector ) * pagesPerSector;
+      const size_t sectorEnd   = std::min( sectorStart + pagesPerSector, numPages );
+
+      for ( size_t page = sectorStart; page < sectorEnd; page++ )
+      {
+        if ( fits( page ) )
+        {
+          return page;
+        }
+      }
+    }
+
+    /*------------------------------------------------
+    Second choice: a sector nobody has touched yet
+    ------------------------------------------------*/
+    for ( size_t page = 0; page < numPages; page += pagesPerSector )
+    {
+      if ( isFree( page, std::min( pagesPerSector, numPages - page ) ) && fits( page ) )
+      {
+        return page;
+      }
+    }
+
+    /*------------------------------------------------
+    Last resort: any run of free pages
+    ------------------------------------------------*/
+    for ( size_t page = 0; page < numPages; page++ )
+    {
+      if ( fits( page ) )
+      {
+        return page;
+      }
+    }
+
+    return NO_PAGE;
+  }
+
+  bool AddressAllocator::isFree( const size_t first, const size_t count ) const
+  {
+    return std::all_of( pageUse.begin() + first, pageUse.begin() + first + count, []( const uint16_t use ) { return use == 0u; } );
+  }
+
+}  // namespace AeroKernel::Parameter
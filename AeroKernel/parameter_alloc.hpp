@@ -0,0 +1,128 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_alloc.hpp
+ *
+ *  Description:
+ *    Address allocator used by the Parameter Manager to place parameters that
+ *    were registered without an explicit address. Allocations are page aware
+ *    so a parameter never needlessly straddles a program page or erase sector,
+ *    and parameters tagged with the same group are packed together so they can
+ *    be read and saved with as few flash transactions as possible.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef AERO_KERNEL_PARAMETER_ALLOC_HPP
+#define AERO_KERNEL_PARAMETER_ALLOC_HPP
+
+/* C++ Includes */
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/* Chimera Includes */
+#include <Chimera/modules/memory/device.hpp>
+
+namespace AeroKernel::Parameter
+{
+  /**
+   *  Page granular allocator over the region of a single storage device.
+   *  Each group owns one open page that its small parameters are packed into.
+   *  New pages for a group are taken from the sector it already occupies when
+   *  possible, then from an untouched sector, so groups tend to own whole
+   *  sectors. Parameters larger than a page get a run of pages that stays
+   *  within one sector whenever it fits.
+   */
+  class AddressAllocator
+  {
+  public:
+    static constexpr uint8_t NO_GROUP         = 0xF; /**< Group of parameters without a placement hint */
+    static constexpr size_t MAX_GROUPS        = 16;  /**< Number of open pages, including NO_GROUP */
+    static constexpr size_t ALIGNMENT         = 4;   /**< Alignment of every allocation */
+    static constexpr size_t DEFAULT_PAGE_SIZE = 256; /**< Granule used when the device has no page size */
+    static constexpr uint32_t INVALID_ADDRESS = std::numeric_limits<uint32_t>::max();
+
+    AddressAllocator();
+    ~AddressAllocator() = default;
+
+    /**
+     *	Prepares the allocator for a region, forgetting any previous allocations
+     *
+     *	@param[in]	specs       Memory region and geometry
+     *	@return bool            False if the region is empty
+     */
+    bool init( const Chimera::Modules::Memory::Descriptor &specs );
+
+    /**
+     *	Disables the allocator
+     *
+     *	@return void
+     */
+    void reset();
+
+    bool isEnabled() const
+    {
+      return !pageUse.empty();
+    }
+
+    /**
+     *	Finds a home for a parameter
+     *
+     *	@param[in]	size        Size of the parameter
+     *	@param[in]	group       Placement group, NO_GROUP if there is no hint
+     *	@return uint32_t        The address, INVALID_ADDRESS if the region is full
+     */
+    uint32_t allocate( const size_t size, const uint8_t group );
+
+    /**
+     *	Marks memory as used by a parameter placed by the user, keeping the
+     *  allocator from handing it out. A group packing one of the claimed pages
+     *  continues after the claimed bytes. Memory outside the region is ignored.
+     *
+     *	@param[in]	address     Start of the parameter
+     *	@param[in]	size        Size of the parameter
+     *	@return void
+     */
+    void claim( const size_t address, const size_t size );
+
+    /**
+     *	Returns memory from allocate() or claim(). Pages are reused once every
+     *  parameter inside them has been released.
+     *
+     *	@param[in]	address     Start of the parameter
+     *	@param[in]	size        Size of the parameter
+     *	@return void
+     */
+    void release( const size_t address, const size_t size );
+
+  private:
+    static constexpr size_t NO_PAGE = std::numeric_limits<size_t>::max();
+
+    struct OpenPage
+    {
+      size_t page; /**< Page the group is currently packing, NO_PAGE if none */
+      size_t used; /**< Bytes already handed out from the page */
+    };
+
+    size_t startAddress;
+    size_t pageSize;
+    size_t pagesPerSector;
+    std::vector<uint16_t> pageUse; /**< Number of parameters touching each page */
+    std::array<OpenPage, MAX_GROUPS> openPages;
+
+    /**
+     *	Finds a run of free pages, preferring the sector of a nearby page
+     *
+     *	@param[in]	count       Number of pages needed
+     *	@param[in]	near        Page whose sector is preferred, NO_PAGE for none
+     *	@return size_t          First page of the run, NO_PAGE if none is free
+     */
+    size_t findPages( const size_t count, const size_t near ) const;
+
+    bool isFree( const size_t first, const size_t count ) const;
+  };
+}  // namespace AeroKernel::Parameter
+
+#endif /* !AERO_KERNEL_PARAMETER_ALLOC_HPP */
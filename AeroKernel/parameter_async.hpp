@@ -0,0 +1,157 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_async.hpp
+ *
+ *  Description:
+ *    Request queues backing the Parameter Manager's asynchronous I/O. Each
+ *    storage device gets its own queue so a slow device never holds up
+ *    requests bound for a fast one.
+ *
+ *    On hosted builds (Linux/Windows) the Manager services the queues with its
+ *    own worker threads. Embedded targets have no portable way to spawn a task
+ *    from here, so the application services them from a task of its own.
+ *    Define AERO_KERNEL_PARAMETER_ASYNC_THREADS to force worker threads on.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef AERO_KERNEL_PARAMETER_ASYNC_HPP
+#define AERO_KERNEL_PARAMETER_ASYNC_HPP
+
+/* C++ Includes */
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/* Chimera Includes */
+#include <Chimera/threading.hpp>
+
+#if !defined( AERO_KERNEL_PARAMETER_ASYNC_THREADS ) && ( defined( __unix__ ) || defined( _WIN32 ) )
+#define AERO_KERNEL_PARAMETER_ASYNC_THREADS
+#endif
+
+namespace AeroKernel::Parameter
+{
+  /**
+   *  Fixed depth FIFO of pending requests. Storage is allocated once by init()
+   *  so queuing a request never allocates.
+   */
+  template<typename T>
+  class AsyncQueue : public Chimera::Threading::Lockable
+  {
+  public:
+    AsyncQueue() : head( 0 ), count( 0 ), closed( false )
+    {
+    }
+
+    ~AsyncQueue() = default;
+
+    /**
+     *	Allocates room for a number of requests, dropping any that are pending,
+     *	and reopens the queue
+     *
+     *	@param[in]	depth       Maximum number of pending requests
+     *	@param[in]	timeout_mS  How long to wait for the queue to be available
+     *	@return bool            False if the queue could not be locked
+     */
+    bool init( const size_t depth, const size_t timeout_mS )
+    {
+      bool result = ( reserve( timeout_mS ) == Chimera::CommonStatusCodes::OK );
+
+      if ( result )
+      {
+        slots.assign( depth, T() );
+        head   = 0;
+        count  = 0;
+        closed = false;
+
+        release();
+      }
+
+      return result;
+    }
+
+    /**
+     *	Refuses any further requests until the next init(). Requests already
+     *	queued can still be popped.
+     *
+     *	@param[in]	timeout_mS  How long to wait for the queue to be available
+     *	@return bool            False if the queue could not be locked
+     */
+    bool close( const size_t timeout_mS )
+    {
+      bool result = ( reserve( timeout_mS ) == Chimera::CommonStatusCodes::OK );
+
+      if ( result )
+      {
+        closed = true;
+        release();
+      }
+
+      return result;
+    }
+
+    /**
+     *	Adds a request to the back of the queue
+     *
+     *	@param[in]	item        The request
+     *	@param[in]	timeout_mS  How long to wait for the queue to be available
+     *	@return bool            False if the queue is full or closed
+     */
+    bool push( T &&item, const size_t timeout_mS )
+    {
+      bool result = false;
+
+      if ( reserve( timeout_mS ) == Chimera::CommonStatusCodes::OK )
+      {
+        if ( !closed && ( count < slots.size() ) )
+        {
+          slots[ ( head + count ) % slots.size() ] = std::move( item );
+          count++;
+          result = true;
+        }
+
+        release();
+      }
+
+      return result;
+    }
+
+    /**
+     *	Removes the request at the front of the queue
+     *
+     *	@param[out]	item        The request
+     *	@param[in]	timeout_mS  How long to wait for the queue to be available
+     *	@return bool            False if the queue is empty
+     */
+    bool pop( T &item, const size_t timeout_mS )
+    {
+      bool result = false;
+
+      if ( reserve( timeout_mS ) == Chimera::CommonStatusCodes::OK )
+      {
+        if ( count )
+        {
+          item          = std::move( slots[ head ] );
+          slots[ head ] = T();
+          head          = ( head + 1u ) % slots.size();
+          count--;
+          result = true;
+        }
+
+        release();
+      }
+
+      return result;
+    }
+
+  private:
+    std::vector<T> slots;
+    size_t head;
+    size_t count;
+    bool closed;
+  };
+}  // namespace AeroKernel::Parameter
+
+#endif /* !AERO_KERNEL_PARAMETER_ASYNC_HPP */
@@ -0,0 +1,168 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_bench.cpp
+ *
+ *  Description:
+ *    Host only benchmark comparing the registry index backends. For a range of
+ *    registry sizes it reports the lookup latency of hits and misses and the
+ *    memory held per entry by SparseMap and FlatMap.
+ *
+ *    FlatMap reports its own footprint through memoryUsage(). sparsepp has no
+ *    such accounting, so its footprint is the growth of the heap while the map
+ *    is built, which is only available when linked against glibc.
+ *
+ *    Build with optimizations enabled and run without arguments.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if defined( __GLIBC__ )
+#include <malloc.h>
+#endif
+
+/* AeroKernel Includes */
+#include <AeroKernel/parameter_index.hpp>
+
+namespace
+{
+  using namespace AeroKernel::Parameter;
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr size_t LOOKUPS = 2000000;  /**< Lookups timed per measurement */
+  static constexpr size_t STRIDE  = 7919;     /**< Prime step through the keys, defeats the prefetcher */
+  static constexpr size_t SIZES[] = { 64, 512, 4096, 32768 };
+
+  struct Result
+  {
+    double hitNs         = 0.0; /**< Average time of a lookup that finds its key */
+    double missNs        = 0.0; /**< Average time of a lookup for an absent key */
+    double bytesPerEntry = 0.0; /**< Memory held by the index divided by the number of keys */
+  };
+
+  /* Keeps the compiler from discarding the lookups */
+  volatile uint32_t sink = 0;
+
+  /**
+   *  Gets the number of bytes currently allocated from the heap
+   *
+   *	@return size_t          Bytes in use, zero if the C library can't tell
+   */
+  size_t heapInUse()
+  {
+#if defined( __GLIBC__ ) && __GLIBC_PREREQ( 2, 33 )
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+  }
+
+  /**
+   *  Times a batch of lookups, visiting the keys in a scattered order
+   *
+   *	@param[in]	map             The index to search
+   *	@param[in]	keys            Keys to look up
+   *	@return double          Average nanoseconds per lookup
+   */
+  template<typename Map>
+  double timeLookups( const Map &map, const std::vector<Key> &keys )
+  {
+    uint32_t found = 0;
+    size_t index   = 0;
+
+    const auto start = Clock::now();
+
+    for ( size_t x = 0; x < LOOKUPS; x++ )
+    {
+      found += map.find( keys[ index ] );
+      index = ( index + STRIDE ) % keys.size();
+    }
+
+    const auto stop = Clock::now();
+    sink            = sink + found;
+
+    return static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>( stop - start ).count() ) / LOOKUPS;
+  }
+
+  /**
+   *  Builds an index holding every key and measures it
+   *
+   *	@param[in]	keys            Keys to register
+   *	@param[in]	absent          Keys that are never registered
+   *	@param[in]	usage           Returns the bytes held by the built map, given the heap growth
+   *	@return Result
+   */
+  template<typename Map, typename Usage>
+  Result measure( const std::vector<Key> &keys, const std::vector<Key> &absent, Usage &&usage )
+  {
+    Result result;
+    const size_t before = heapInUse();
+
+    Map map;
+    map.init( keys.size() );
+
+    for ( size_t x = 0; x < keys.size(); x++ )
+    {
+      map.insert( keys[ x ], static_cast<uint16_t>( x ) );
+    }
+
+    result.bytesPerEntry = static_cast<double>( usage( map, heapInUse() - before ) ) / keys.size();
+    result.hitNs         = timeLookups( map, keys );
+    result.missNs        = timeLookups( map, absent );
+
+    return result;
+  }
+
+  void report( const char *const backend, const size_t count, const Result &result )
+  {
+    printf( "%-10s %8zu %12.2f %12.2f %14.2f\n", backend, count, result.hitNs, result.missNs, result.bytesPerEntry );
+  }
+}  // namespace
+
+int main()
+{
+  printf( "%-10s %8s %12s %12s %14s\n", "backend", "entries", "hit ns/op", "miss ns/op", "bytes/entry" );
+
+  for ( const size_t count : SIZES )
+  {
+    /*------------------------------------------------
+    Keys only hold a view of their name, so every name has to be in
+    place before the first key refers to it
+    ------------------------------------------------*/
+    std::vector<std::string> names;
+    std::vector<Key> keys;
+    std::vector<Key> absent;
+
+    names.reserve( count * 2u );
+
+    for ( size_t x = 0; x < count; x++ )
+    {
+      names.push_back( "bench.present." + std::to_string( x ) );
+      names.push_back( "bench.absent." + std::to_string( x ) );
+    }
+
+    for ( size_t x = 0; x < count; x++ )
+    {
+      keys.emplace_back( names[ 2u * x ] );
+      absent.emplace_back( names[ ( 2u * x ) + 1u ] );
+    }
+
+    report( "sparsepp", count,
+            measure<SparseMap>( keys, absent, []( const SparseMap &, const size_t heapGrowth ) { return heapGrowth; } ) );
+
+    report( "flat", count,
+            measure<FlatMap>( keys, absent, []( const FlatMap &map, const size_t ) { return map.memoryUsage(); } ) );
+  }
+
+  if ( !heapInUse() )
+  {
+    printf( "\nHeap accounting is unavailable, sparsepp bytes/entry could not be measured\n" );
+  }
+
+  return 0;
+}
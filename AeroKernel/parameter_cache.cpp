@@ -0,0 +1,158 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_cache.cpp
+ *
+ *  Description:
+ *    Implements the Parameter Manager RAM cache.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#include <AeroKernel/parameter_cache.hpp>
+
+namespace AeroKernel::Parameter
+{
+  Cache::Cache() : policy( EvictionPolicy::LEAST_RECENTLY_USED ), lineSize( 0 ), hand( 0 ), clock( 0 ), numDirty( 0 )
+  {
+  }
+
+  bool Cache::init( const CacheConfig &config, const size_t numSlots )
+  {
+    bool result = ( config.lines < NO_LINE );
+
+    if ( result )
+    {
+      policy   = config.policy;
+      lineSize = config.lines ? config.lineSize : 0u;
+      hand     = 0;
+      clock    = 0;
+
+      lines.assign( config.lines, Line() );
+      storage.assign( config.lines * lineSize, 0u );
+      lineOfSlot.assign( config.lines ? numSlots : 0u, NO_LINE );
+      dirtyMap.assign( ( lineOfSlot.size() + DIRTY_WORD_BITS - 1u ) / DIRTY_WORD_BITS, 0u );
+      numDirty = 0;
+    }
+
+    return result;
+  }
+
+  Cache::Line *Cache::find( const uint16_t slot )
+  {
+    Line *result = nullptr;
+
+    if ( ( slot < lineOfSlot.size() ) && ( lineOfSlot[ slot ] != NO_LINE ) )
+    {
+      result = &lines[ lineOfSlot[ slot ] ];
+      touch( *result );
+    }
+
+    return result;
+  }
+
+  Cache::Line &Cache::victim()
+  {
+    size_t index = 0;
+
+    if ( policy == EvictionPolicy::CLOCK )
+    {
+      /*------------------------------------------------
+      Sweep the hand, clearing reference bits, until an unreferenced
+      line is found. This terminates within two revolutions.
+      ------------------------------------------------*/
+      while ( lines[ hand ].referenced )
+      {
+        lines[ hand ].referenced = false;
+        hand                     = ( hand + 1u ) % lines.size();
+      }
+
+      index = hand;
+      hand  = ( hand + 1u ) % lines.size();
+    }
+    else
+    {
+      for ( size_t x = 0; x < lines.size(); x++ )
+      {
+        if ( lines[ x ].slot == NO_LINE )
+        {
+          index = x;
+          break;
+        }
+
+        /* Unsigned difference keeps the ordering correct across clock wrap */
+        if ( ( clock - lines[ x ].lastUse ) > ( clock - lines[ index ].lastUse ) )
+        {
+          index = x;
+        }
+      }
+    }
+
+    return lines[ index ];
+  }
+
+  void Cache::assign( Line &line, const uint16_t slot, const uint8_t storage, const uint32_t address, const uint32_t size )
+  {
+    if ( line.slot != NO_LINE )
+    {
+      setDirty( line, false );
+      lineOfSlot[ line.slot ] = NO_LINE;
+    }
+
+    line.slot    = slot;
+    line.storage = storage;
+    line.address = address;
+    line.size    = size;
+
+    lineOfSlot[ slot ] = static_cast<uint16_t>( &line - lines.data() );
+    touch( line );
+  }
+
+  void Cache::invalidate( Line &line )
+  {
+    if ( line.slot != NO_LINE )
+    {
+      setDirty( line, false );
+      lineOfSlot[ line.slot ] = NO_LINE;
+    }
+
+    line = Line();
+  }
+
+  void Cache::setDirty( Line &line, const bool dirty )
+  {
+    if ( ( line.slot != NO_LINE ) && ( line.dirty != dirty ) )
+    {
+      const uint32_t mask = 1u << ( line.slot % DIRTY_WORD_BITS );
+
+      if ( dirty )
+      {
+        dirtyMap[ line.slot / DIRTY_WORD_BITS ] |= mask;
+        numDirty++;
+      }
+      else
+      {
+        dirtyMap[ line.slot / DIRTY_WORD_BITS ] &= ~mask;
+        numDirty--;
+      }
+
+      line.dirty = dirty;
+    }
+  }
+
+  bool Cache::isDirty( const uint16_t slot ) const
+  {
+    return ( slot < lineOfSlot.size() ) && ( dirtyMap[ slot / DIRTY_WORD_BITS ] & ( 1u << ( slot % DIRTY_WORD_BITS ) ) );
+  }
+
+  uint8_t *Cache::data( const Line &line )
+  {
+    return storage.data() + ( &line - lines.data() ) * lineSize;
+  }
+
+  void Cache::touch( Line &line )
+  {
+    line.referenced = true;
+    line.lastUse    = ++clock;
+  }
+
+}  // namespace AeroKernel::Parameter
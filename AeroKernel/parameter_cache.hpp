@@ -0,0 +1,202 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_cache.hpp
+ *
+ *  Description:
+ *    RAM cache used by the Parameter Manager to hide the latency of flash
+ *    backed parameters. Reads are served from SRAM once a parameter has been
+ *    fetched and writes are held in SRAM until explicitly flushed, or until
+ *    the line has to be evicted to make room for another parameter.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef AERO_KERNEL_PARAMETER_CACHE_HPP
+#define AERO_KERNEL_PARAMETER_CACHE_HPP
+
+/* C++ Includes */
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/* Chimera Includes */
+#include <Chimera/threading.hpp>
+
+namespace AeroKernel::Parameter
+{
+  enum class EvictionPolicy : uint8_t
+  {
+    LEAST_RECENTLY_USED, /**< Evict the line that was accessed longest ago */
+    CLOCK,               /**< Second chance sweep, cheaper bookkeeping than true LRU */
+  };
+
+  struct CacheConfig
+  {
+    size_t lines          = 0;                                   /**< Number of parameters that can be cached, zero disables the cache */
+    size_t lineSize       = 0;                                   /**< Largest parameter that can be cached, larger ones bypass the cache */
+    EvictionPolicy policy = EvictionPolicy::LEAST_RECENTLY_USED; /**< How to pick a line to replace */
+  };
+
+  /**
+   *  Fixed size, fully associative parameter cache. Each line holds a single
+   *  parameter along with enough information to write it back to its storage
+   *  device without consulting the registry. The cache performs no I/O on its
+   *  own; the owner fills lines and writes back dirty victims. Dirty lines are
+   *  also tracked in a bitmap indexed by slot, so the owner can find every
+   *  pending write without scanning the lines. All accesses must be made
+   *  while holding the cache's lock.
+   */
+  class Cache : public Chimera::Threading::Lockable
+  {
+  public:
+    static constexpr uint16_t NO_LINE = std::numeric_limits<uint16_t>::max();
+
+    struct Line
+    {
+      uint16_t slot    = NO_LINE; /**< Control block slot of the cached parameter */
+      uint8_t storage  = 0;       /**< StorageType the parameter is written back to */
+      bool dirty       = false;   /**< Data has been written but not yet flushed */
+      bool referenced  = false;   /**< CLOCK policy second chance bit */
+      uint32_t address = 0;       /**< Storage address of the parameter */
+      uint32_t size    = 0;       /**< Size of the parameter */
+      uint32_t lastUse = 0;       /**< LRU policy timestamp */
+    };
+
+    Cache();
+    ~Cache() = default;
+
+    /**
+     *	Allocates the cache, dropping any previous contents. Dirty lines must be
+     *  flushed by the owner beforehand.
+     *
+     *	@param[in]	config      Cache dimensions and eviction policy
+     *	@param[in]	numSlots    Number of control block slots that may be cached
+     *	@return bool
+     */
+    bool init( const CacheConfig &config, const size_t numSlots );
+
+    bool isEnabled() const
+    {
+      return !lines.empty();
+    }
+
+    bool canHold( const size_t size ) const
+    {
+      return isEnabled() && ( size <= lineSize );
+    }
+
+    /**
+     *	Finds the line holding a slot and records the access
+     *
+     *	@param[in]	slot        Control block slot
+     *	@return Line *          nullptr on a miss
+     */
+    Line *find( const uint16_t slot );
+
+    /**
+     *	Picks the line to hold a new parameter according to the eviction policy.
+     *  If the returned line is dirty, it must be written back before reuse.
+     *
+     *	@return Line &
+     */
+    Line &victim();
+
+    /**
+     *	Binds a line to a parameter
+     *
+     *	@return void
+     */
+    void assign( Line &line, const uint16_t slot, const uint8_t storage, const uint32_t address, const uint32_t size );
+
+    /**
+     *	Drops a line's contents without writing it back
+     *
+     *	@return void
+     */
+    void invalidate( Line &line );
+
+    /**
+     *	Marks whether a line holds data that has not reached its storage device
+     *
+     *	@param[in]	line        The line to mark
+     *	@param[in]	dirty       True if the line was written, false once written back
+     *	@return void
+     */
+    void setDirty( Line &line, const bool dirty );
+
+    /**
+     *	Checks if a slot has a write waiting in the cache
+     *
+     *	@param[in]	slot        Control block slot
+     *	@return bool
+     */
+    bool isDirty( const uint16_t slot ) const;
+
+    /**
+     *	Gets the number of lines waiting to be written back
+     *
+     *	@return size_t
+     */
+    size_t dirtyCount() const
+    {
+      return numDirty;
+    }
+
+    /**
+     *	Visits every dirty line in ascending slot order. Whole words of the
+     *  bitmap are skipped at a time, so clean slots cost next to nothing.
+     *
+     *	@param[in]	func        Called with each dirty line
+     *	@return void
+     */
+    template<typename Visitor>
+    void forEachDirty( Visitor &&func )
+    {
+      for ( size_t word = 0; word < dirtyMap.size(); word++ )
+      {
+        for ( uint32_t bits = dirtyMap[ word ]; bits; bits &= ( bits - 1u ) )
+        {
+          size_t bit = 0;
+
+          while ( !( bits & ( 1u << bit ) ) )
+          {
+            bit++;
+          }
+
+          func( lines[ lineOfSlot[ ( word * DIRTY_WORD_BITS ) + bit ] ] );
+        }
+      }
+    }
+
+    uint8_t *data( const Line &line );
+
+    size_t lineCount() const
+    {
+      return lines.size();
+    }
+
+    Line &line( const size_t index )
+    {
+      return lines[ index ];
+    }
+
+  private:
+    static constexpr size_t DIRTY_WORD_BITS = 32;
+
+    EvictionPolicy policy;
+    size_t lineSize;
+    size_t hand;
+    uint32_t clock;
+    std::vector<Line> lines;
+    std::vector<uint8_t> storage;
+    std::vector<uint16_t> lineOfSlot;
+    std::vector<uint32_t> dirtyMap;
+    size_t numDirty;
+
+    void touch( Line &line );
+  };
+
+}  // namespace AeroKernel::Parameter
+
+#endif /* !AERO_KERNEL_PARAMETER_CACHE_HPP */
@@ -0,0 +1,449 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_index.cpp
+ *
+ *  Description:
+ *    Implements the Parameter Manager lookup structures.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <algorithm>
+
+#include <AeroKernel/parameter_index.hpp>
+
+namespace AeroKernel::Parameter
+{
+  namespace CHD
+  {
+    static constexpr size_t KEYS_PER_BUCKET = 2u;     /**< Average bucket load, trades build time for table size */
+    static constexpr uint32_t MAX_SEEDS     = 16u;    /**< Number of global seeds tried before giving up */
+    static constexpr uint32_t MAX_DISP      = 0xFFFF; /**< Displacements tried per bucket before reseeding */
+  }  // namespace CHD
+
+  /*------------------------------------------------
+  SparseMap
+  ------------------------------------------------*/
+  bool SparseMap::init( const size_t capacity )
+  {
+    map.clear();
+    map.resize( capacity );
+    map.set_resizing_parameters( 0.0f, 0.1f );
+    return true;
+  }
+
+  bool SparseMap::insert( const Key &key, const uint16_t slot )
+  {
+    return map.insert( { key, slot } ).second;
+  }
+
+  uint16_t SparseMap::erase( const Key &key )
+  {
+    uint16_t result = INVALID_SLOT;
+    auto iter       = map.find( key );
+
+    if ( iter != map.end() )
+    {
+      result = iter->second;
+      map.erase( iter );
+    }
+
+    return result;
+  }
+
+  void SparseMap::clear()
+  {
+    map.clear();
+  }
+
+  size_t SparseMap::size() const
+  {
+    return map.size();
+  }
+
+  /*------------------------------------------------
+  FlatMap
+  ------------------------------------------------*/
+  FlatMap::FlatMap() : groupMask( 0 ), numKeys( 0 )
+  {
+  }
+
+  bool FlatMap::init( const size_t capacity )
+  {
+    /*------------------------------------------------
+    Round up to a power of two number of groups that keeps the
+    load factor at or below 7/8 when completely full.
+    ------------------------------------------------*/
+    const size_t minPositions = ( capacity * 8u + 6u ) / 7u;
+    size_t numGroups          = 1u;
+
+    while ( numGroups * GROUP_WIDTH < minPositions )
+    {
+      numGroups <<= 1;
+    }
+
+    groupMask = numGroups - 1u;
+    numKeys   = 0u;
+
+    control.assign( numGroups * GROUP_WIDTH, EMPTY );
+    hashes.assign( control.size(), 0u );
+    names.assign( control.size(), std::string_view() );
+    slots.assign( control.size(), INVALID_SLOT );
+
+    return true;
+  }
+
+  bool FlatMap::insert( const Key &key, const uint16_t slot )
+  {
+    bool result = false;
+
+    if ( !control.empty() && ( locate( key ) == NOT_FOUND ) )
+    {
+      const uint32_t mixed = mixHash( key.getHash() );
+      size_t group         = h1( mixed ) & groupMask;
+
+      for ( size_t probe = 1; probe <= groupMask + 1u; probe++ )
+      {
+        const uint64_t available = matchEmptyOrDeleted( loadGroup( group ) );
+
+        if ( available )
+        {
+          const size_t pos = group * GROUP_WIDTH + lowestMatch( available );
+
+          control[ pos ] = h2( mixed );
+          hashes[ pos ]  = key.getHash();
+          names[ pos ]   = key.view();
+          slots[ pos ]   = slot;
+
+          numKeys++;
+          result = true;
+          break;
+        }
+
+        group = ( group + probe ) & groupMask;
+      }
+    }
+
+    return result;
+  }
+
+  uint16_t FlatMap::erase( const Key &key )
+  {
+    uint16_t result  = INVALID_SLOT;
+    const size_t pos = locate( key );
+
+    if ( pos != NOT_FOUND )
+    {
+      /*------------------------------------------------
+      A position can go straight back to empty if its group was never
+      full, since no probe sequence could have passed through it.
+      ------------------------------------------------*/
+      result         = slots[ pos ];
+      control[ pos ] = matchEmpty( loadGroup( pos / GROUP_WIDTH ) ) ? EMPTY : DELETED;
+      names[ pos ]   = std::string_view();
+      slots[ pos ]   = INVALID_SLOT;
+      numKeys--;
+    }
+
+    return result;
+  }
+
+  void FlatMap::clear()
+  {
+    std::fill( control.begin(), control.end(), EMPTY );
+    numKeys = 0u;
+  }
+
+  size_t FlatMap::size() const
+  {
+    return numKeys;
+  }
+
+  size_t FlatMap::memoryUsage() const
+  {
+    return control.capacity() * sizeof( uint8_t ) + hashes.capacity() * sizeof( uint32_t )
+           + names.capacity() * sizeof( std::string_view ) + slots.capacity() * sizeof( uint16_t );
+  }
+
+  /*------------------------------------------------
+  KeyArena
+  ------------------------------------------------*/
+  KeyArena::KeyArena() : chunkSize( 0 ), chunkUsed( 0 ), allocated( 0 )
+  {
+  }
+
+  void KeyArena::init( const size_t chunkSize )
+  {
+    chunks.clear();
+    this->chunkSize = chunkSize;
+    chunkUsed       = 0;
+    allocated       = 0;
+  }
+
+  Key KeyArena::intern( const Key &key )
+  {
+    return intern( key.view(), key.getHash() );
+  }
+
+  Key KeyArena::intern( const std::string_view &name, const uint32_t hash )
+  {
+    /*------------------------------------------------
+    Start a new chunk if the name doesn't fit in the current one. Names
+    larger than a chunk get a dedicated allocation.
+    ------------------------------------------------*/
+    if ( chunks.empty() || ( ( chunkUsed + name.size() ) > chunkSize ) )
+    {
+      const size_t size = std::max( chunkSize, name.size() );
+
+      chunks.emplace_back( new char[ size ] );
+      chunkUsed = 0;
+      allocated += size;
+    }
+
+    char *const dest = chunks.back().get() + chunkUsed;
+    memcpy( dest, name.data(), name.size() );
+    chunkUsed += name.size();
+
+    return Key( std::string_view( dest, name.size() ), hash );
+  }
+
+  size_t KeyArena::memoryUsage() const
+  {
+    return allocated;
+  }
+
+  /*------------------------------------------------
+  KeyTree
+  ------------------------------------------------*/
+  void KeyTree::init( const size_t capacity )
+  {
+    nodes.clear();
+    nodes.reserve( capacity * 2u + 1u );
+    nodes.push_back( { std::string_view(), NONE, NONE, NONE, INVALID_SLOT } );
+  }
+
+  bool KeyTree::insert( const std::string_view &name, const uint16_t slot )
+  {
+    if ( nodes.empty() || name.empty() )
+    {
+      return false;
+    }
+
+    uint32_t node = 0;
+    size_t start  = 0;
+
+    while ( start <= name.size() )
+    {
+      size_t end = name.find( SEPARATOR, start );
+      if ( end == std::string_view::npos )
+      {
+        end = name.size();
+      }
+
+      const std::string_view segment = name.substr( start, end - start );
+      uint32_t child                 = findChild( node, segment );
+
+      if ( child == NONE )
+      {
+        child = static_cast<uint32_t>( nodes.size() );
+        nodes.push_back( { segment, node, NONE, nodes[ node ].firstChild, INVALID_SLOT } );
+        nodes[ node ].firstChild = child;
+      }
+
+      node  = child;
+      start = end + 1u;
+    }
+
+    nodes[ node ].slot = slot;
+    return true;
+  }
+
+  bool KeyTree::erase( const std::string_view &name )
+  {
+    const uint32_t node = locate( name );
+    bool result         = false;
+
+    if ( ( node != NONE ) && ( node != 0 ) )
+    {
+      result             = ( nodes[ node ].slot != INVALID_SLOT );
+      nodes[ node ].slot = INVALID_SLOT;
+    }
+
+    return result;
+  }
+
+  uint32_t KeyTree::findChild( const uint32_t parent, const std::string_view &segment ) const
+  {
+    uint32_t child = nodes[ parent ].firstChild;
+
+    while ( ( child != NONE ) && ( nodes[ child ].segment != segment ) )
+    {
+      child = nodes[ child ].nextSibling;
+    }
+
+    return child;
+  }
+
+  uint32_t KeyTree::locate( const std::string_view &name ) const
+  {
+    uint32_t node = nodes.empty() ? NONE : 0u;
+    size_t start  = 0;
+
+    while ( ( node != NONE ) && !name.empty() && ( start <= name.size() ) )
+    {
+      size_t end = name.find( SEPARATOR, start );
+      if ( end == std::string_view::npos )
+      {
+        end = name.size();
+      }
+
+      node  = findChild( node, name.substr( start, end - start ) );
+      start = end + 1u;
+    }
+
+    return node;
+  }
+
+  /*------------------------------------------------
+  PerfectHash
+  ------------------------------------------------*/
+  PerfectHash::PerfectHash() : seed( 0 )
+  {
+  }
+
+  bool PerfectHash::build( const std::vector<std::pair<Key, uint16_t>> &entries )
+  {
+    clear();
+
+    const size_t numKeys = entries.size();
+    if ( !numKeys )
+    {
+      return true;
+    }
+
+    /*------------------------------------------------
+    Keys sharing a full hash can never be separated, so reject them early
+    ------------------------------------------------*/
+    std::vector<uint32_t> hashes;
+    hashes.reserve( numKeys );
+
+    for ( const auto &entry : entries )
+    {
+      hashes.push_back( entry.first.getHash() );
+    }
+
+    std::sort( hashes.begin(), hashes.end() );
+    if ( std::adjacent_find( hashes.begin(), hashes.end() ) != hashes.end() )
+    {
+      return false;
+    }
+
+    const size_t numBuckets = ( numKeys + CHD::KEYS_PER_BUCKET - 1u ) / CHD::KEYS_PER_BUCKET;
+
+    table.resize( numKeys );
+    displacement.resize( numBuckets );
+
+    std::vector<std::vector<size_t>> buckets( numBuckets );
+    std::vector<size_t> order( numBuckets );
+    std::vector<bool> occupied( numKeys );
+    std::vector<uint32_t> positions;
+
+    for ( uint32_t attempt = 0; attempt < CHD::MAX_SEEDS; attempt++ )
+    {
+      seed = mixHash( attempt + 1u );
+
+      /*------------------------------------------------
+      Distribute the keys into buckets and place the largest buckets first,
+      while the table still has plenty of room.
+      ------------------------------------------------*/
+      for ( auto &bucket : buckets )
+      {
+        bucket.clear();
+      }
+
+      for ( size_t x = 0; x < numKeys; x++ )
+      {
+        const uint32_t mixed = entries[ x ].first.getHash() ^ seed;
+        buckets[ reduce( mixHash( mixed ), static_cast<uint32_t>( numBuckets ) ) ].push_back( x );
+      }
+
+      for ( size_t x = 0; x < numBuckets; x++ )
+      {
+        order[ x ] = x;
+      }
+
+      std::stable_sort( order.begin(), order.end(),
+                        [ &buckets ]( const size_t a, const size_t b ) { return buckets[ a ].size() > buckets[ b ].size(); } );
+
+      std::fill( occupied.begin(), occupied.end(), false );
+      std::fill( displacement.begin(), displacement.end(), 0u );
+
+      bool placedAll = true;
+
+      for ( const size_t bucketIdx : order )
+      {
+        const auto &bucket = buckets[ bucketIdx ];
+        if ( bucket.empty() )
+        {
+          break;
+        }
+
+        bool placed = false;
+
+        for ( uint32_t disp = 0; !placed && ( disp <= CHD::MAX_DISP ); disp++ )
+        {
+          positions.clear();
+          placed = true;
+
+          for ( const size_t keyIdx : bucket )
+          {
+            const uint32_t pos = position( entries[ keyIdx ].first.getHash() ^ seed, static_cast<uint16_t>( disp ) );
+
+            if ( occupied[ pos ] || ( std::find( positions.begin(), positions.end(), pos ) != positions.end() ) )
+            {
+              placed = false;
+              break;
+            }
+
+            positions.push_back( pos );
+          }
+
+          if ( placed )
+          {
+            displacement[ bucketIdx ] = static_cast<uint16_t>( disp );
+
+            for ( size_t x = 0; x < bucket.size(); x++ )
+            {
+              occupied[ positions[ x ] ]   = true;
+              table[ positions[ x ] ].key  = entries[ bucket[ x ] ].first;
+              table[ positions[ x ] ].slot = entries[ bucket[ x ] ].second;
+            }
+          }
+        }
+
+        if ( !placed )
+        {
+          placedAll = false;
+          break;
+        }
+      }
+
+      if ( placedAll )
+      {
+        return true;
+      }
+    }
+
+    clear();
+    return false;
+  }
+
+  void PerfectHash::clear()
+  {
+    seed = 0;
+    displacement.clear();
+    table.clear();
+  }
+
+}  // namespace AeroKernel::Parameter
@@ -0,0 +1,586 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_index.hpp
+ *
+ *  Description:
+ *    Lookup structures used by the Parameter Manager to resolve a parameter key
+ *    into the slot of its control block.
+ *
+ *    The backend used for the mutable registry is selected at compile time.
+ *    By default the sparsepp hash map is used, which favors memory density.
+ *    Defining AERO_KERNEL_PARAMETER_FLAT_MAP selects an open addressing flat
+ *    table instead, which favors lookup latency.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef AERO_KERNEL_PARAMETER_INDEX_HPP
+#define AERO_KERNEL_PARAMETER_INDEX_HPP
+
+/* C++ Includes */
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/* Hash Map Include */
+#include <sparsepp/spp.h>
+
+/* AeroKernel Includes */
+#include <AeroKernel/parameter_key.hpp>
+
+namespace AeroKernel::Parameter
+{
+  /**
+   *  Value returned by the index structures when a key is not present
+   */
+  static constexpr uint16_t INVALID_SLOT = std::numeric_limits<uint16_t>::max();
+
+  /**
+   *  Murmur3 finalizer. FNV-1a leaves the low bits of a key hash poorly
+   *  distributed, so the index structures mix it before use.
+   */
+  static constexpr uint32_t mixHash( uint32_t x )
+  {
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+  }
+
+  /**
+   *  Registry index backed by the sparsepp hash map. The map is sized once
+   *  from the expected number of parameters and is not allowed to shrink.
+   */
+  class SparseMap
+  {
+  public:
+    SparseMap()  = default;
+    ~SparseMap() = default;
+
+    /**
+     *	Clears the map and sizes it for the given number of keys
+     *
+     *	@param[in]	capacity    Number of keys the map is expected to hold
+     *	@return bool
+     */
+    bool init( const size_t capacity );
+
+    /**
+     *	Looks up the slot associated with a key using a single probe
+     *
+     *	@param[in]	key         The parameter's name
+     *	@return uint16_t        The slot, or INVALID_SLOT if the key is not present
+     */
+    uint16_t find( const Key &key ) const
+    {
+      auto iter = map.find( key );
+      return ( iter != map.end() ) ? iter->second : INVALID_SLOT;
+    }
+
+    /**
+     *	Adds a key that is not yet present in the map
+     *
+     *	@param[in]	key         The parameter's name
+     *	@param[in]	slot        Slot the key resolves to
+     *	@return bool
+     */
+    bool insert( const Key &key, const uint16_t slot );
+
+    /**
+     *	Removes a key from the map
+     *
+     *	@param[in]	key         The parameter's name
+     *	@return uint16_t        The slot the key resolved to, or INVALID_SLOT if not present
+     */
+    uint16_t erase( const Key &key );
+
+    void clear();
+
+    size_t size() const;
+
+    /**
+     *	Invokes func( const Key &, uint16_t ) for every key in the map
+     */
+    template<typename Func>
+    void forEach( Func &&func ) const
+    {
+      for ( const auto &entry : map )
+      {
+        func( entry.first, entry.second );
+      }
+    }
+
+  private:
+    spp::sparse_hash_map<Key, uint16_t, KeyHasher> map;
+  };
+
+  /**
+   *  Open addressing hash table in the style of SwissTable. Every position
+   *  has a one byte control word holding either an empty/deleted marker or
+   *  seven bits of the key's hash, and positions are probed a group of eight
+   *  control words at a time. Hashes, names and slots are stored in separate
+   *  arrays so a probe only touches the control words until a likely match
+   *  is found.
+   *
+   *  The table is sized once by init() and never rehashes, so inserts fail
+   *  rather than allocate once it is full.
+   */
+  class FlatMap
+  {
+  public:
+    FlatMap();
+    ~FlatMap() = default;
+
+    /**
+     *	Clears the map and allocates enough positions for the given number of
+     *  keys while keeping the load factor at or below 7/8.
+     *
+     *	@param[in]	capacity    Number of keys the map must be able to hold
+     *	@return bool
+     */
+    bool init( const size_t capacity );
+
+    /**
+     *	Looks up the slot associated with a key
+     *
+     *	@param[in]	key         The parameter's name
+     *	@return uint16_t        The slot, or INVALID_SLOT if the key is not present
+     */
+    uint16_t find( const Key &key ) const
+    {
+      const size_t pos = locate( key );
+      return ( pos != NOT_FOUND ) ? slots[ pos ] : INVALID_SLOT;
+    }
+
+    /**
+     *	Adds a key that is not yet present in the map
+     *
+     *	@param[in]	key         The parameter's name
+     *	@param[in]	slot        Slot the key resolves to
+     *	@return bool            False if the table is full
+     */
+    bool insert( const Key &key, const uint16_t slot );
+
+    /**
+     *	Removes a key from the map
+     *
+     *	@param[in]	key         The parameter's name
+     *	@return uint16_t        The slot the key resolved to, or INVALID_SLOT if not present
+     */
+    uint16_t erase( const Key &key );
+
+    void clear();
+
+    size_t size() const;
+
+    /**
+     *	Gets the number of bytes allocated by the table, for comparing backends
+     *
+     *	@return size_t
+     */
+    size_t memoryUsage() const;
+
+    /**
+     *	Invokes func( const Key &, uint16_t ) for every key in the map
+     */
+    template<typename Func>
+    void forEach( Func &&func ) const
+    {
+      for ( size_t x = 0; x < control.size(); x++ )
+      {
+        if ( isFull( control[ x ] ) )
+        {
+          func( Key( names[ x ], hashes[ x ] ), slots[ x ] );
+        }
+      }
+    }
+
+  private:
+    static constexpr size_t GROUP_WIDTH = 8u;
+    static constexpr size_t NOT_FOUND   = std::numeric_limits<size_t>::max();
+    static constexpr uint8_t EMPTY      = 0x80; /**< Position has never been used, terminates probing */
+    static constexpr uint8_t DELETED    = 0xFE; /**< Position held a key that was erased */
+    static constexpr uint64_t LSBS      = 0x0101010101010101ull;
+    static constexpr uint64_t MSBS      = 0x8080808080808080ull;
+
+    size_t groupMask;
+    size_t numKeys;
+    std::vector<uint8_t> control;
+    std::vector<uint32_t> hashes;
+    std::vector<std::string_view> names;
+    std::vector<uint16_t> slots;
+
+    static constexpr bool isFull( const uint8_t ctrl )
+    {
+      return ( ctrl & 0x80 ) == 0;
+    }
+
+    static constexpr uint8_t h2( const uint32_t mixed )
+    {
+      return static_cast<uint8_t>( mixed & 0x7F );
+    }
+
+    static constexpr size_t h1( const uint32_t mixed )
+    {
+      return mixed >> 7;
+    }
+
+    /**
+     *  Loads the control words of a group. Bit 7 of byte N in the result
+     *  corresponds to position N of the group on little endian targets.
+     */
+    uint64_t loadGroup( const size_t group ) const
+    {
+      uint64_t result;
+      memcpy( &result, &control[ group * GROUP_WIDTH ], sizeof( result ) );
+      return result;
+    }
+
+    /**
+     *  Flags every control word in the group that may equal the given value.
+     *  Borrows can produce false positives, which the caller filters out by
+     *  comparing the full hash.
+     */
+    static constexpr uint64_t matchByte( const uint64_t group, const uint8_t value )
+    {
+      const uint64_t x = group ^ ( LSBS * value );
+      return ( x - LSBS ) & ~x & MSBS;
+    }
+
+    static constexpr uint64_t matchEmpty( const uint64_t group )
+    {
+      return group & ~( group << 6 ) & MSBS;
+    }
+
+    static constexpr uint64_t matchEmptyOrDeleted( const uint64_t group )
+    {
+      return group & MSBS;
+    }
+
+    static size_t lowestMatch( const uint64_t mask )
+    {
+#if defined( __GNUC__ )
+      return static_cast<size_t>( __builtin_ctzll( mask ) ) / 8u;
+#else
+      size_t result = 0;
+      while ( !( mask & ( 0x80ull << ( result * 8u ) ) ) )
+      {
+        result++;
+      }
+      return result;
+#endif
+    }
+
+    size_t locate( const Key &key ) const
+    {
+      size_t result = NOT_FOUND;
+
+      if ( !control.empty() )
+      {
+        const uint32_t mixed = mixHash( key.getHash() );
+        size_t group         = h1( mixed ) & groupMask;
+
+        /*------------------------------------------------
+        Triangular probing visits every group exactly once
+        ------------------------------------------------*/
+        for ( size_t probe = 1; probe <= groupMask + 1u; probe++ )
+        {
+          const uint64_t ctrl = loadGroup( group );
+
+          for ( uint64_t match = matchByte( ctrl, h2( mixed ) ); match; match &= match - 1u )
+          {
+            const size_t pos = group * GROUP_WIDTH + lowestMatch( match );
+
+            if ( ( hashes[ pos ] == key.getHash() ) && Key::sameName( names[ pos ], key.view() ) )
+            {
+              return pos;
+            }
+          }
+
+          if ( matchEmpty( ctrl ) )
+          {
+            break;
+          }
+
+          group = ( group + probe ) & groupMask;
+        }
+      }
+
+      return result;
+    }
+  };
+
+  /**
+   *  Owns the characters of every registered parameter name. Names are copied
+   *  back to back into large chunks, so the index never references caller
+   *  memory, and the canonical views handed out compare equal by pointer.
+   *  Chunks are never reallocated, so a canonical view stays valid until the
+   *  arena is reset. Space is not reclaimed when a parameter is unregistered.
+   */
+  class KeyArena
+  {
+  public:
+    static constexpr size_t AVERAGE_KEY_LENGTH = 24u; /**< Used to size chunks from a parameter count */
+
+    KeyArena();
+    ~KeyArena() = default;
+
+    /**
+     *	Releases every interned name and sets the size of future chunks
+     *
+     *	@param[in]	chunkSize   Bytes allocated each time the arena runs out of room
+     *	@return void
+     */
+    void init( const size_t chunkSize );
+
+    /**
+     *	Copies a key's name into the arena
+     *
+     *	@param[in]	key         The key to copy
+     *	@return Key             The canonical key, referencing the arena's copy of the name
+     */
+    Key intern( const Key &key );
+
+    /**
+     *	Copies a name whose hash is already known into the arena, such as one
+     *  read back from a registry image, without hashing it again
+     *
+     *	@param[in]	name        The name to copy
+     *	@param[in]	hash        Hash of the name, as given by Key::hashOf()
+     *	@return Key             The canonical key, referencing the arena's copy of the name
+     */
+    Key intern( const std::string_view &name, const uint32_t hash );
+
+    /**
+     *	Gets the number of bytes allocated by the arena
+     *
+     *	@return size_t
+     */
+    size_t memoryUsage() const;
+
+  private:
+    size_t chunkSize;
+    size_t chunkUsed;
+    size_t allocated;
+    std::vector<std::unique_ptr<char[]>> chunks;
+  };
+
+  /**
+   *  Tree of the dotted namespaces found in parameter names, ie "nav.ekf.q0"
+   *  lives at nav -> ekf -> q0. This allows every parameter under a namespace
+   *  to be enumerated without visiting unrelated keys. Node names reference
+   *  the canonical key characters held by a KeyArena, so the tree itself
+   *  stores no strings. Nodes are not pruned when a key is removed, but are
+   *  reused if the namespace is populated again.
+   */
+  class KeyTree
+  {
+  public:
+    static constexpr char SEPARATOR = '.';
+
+    KeyTree() = default;
+    ~KeyTree() = default;
+
+    /**
+     *	Clears the tree and reserves room for the given number of keys
+     *
+     *	@param[in]	capacity    Number of keys the tree is expected to hold
+     *	@return void
+     */
+    void init( const size_t capacity );
+
+    /**
+     *	Adds a key to the tree
+     *
+     *	@param[in]	name        Canonical name of the key, must outlive the tree
+     *	@param[in]	slot        Slot the key resolves to
+     *	@return bool
+     */
+    bool insert( const std::string_view &name, const uint16_t slot );
+
+    /**
+     *	Removes a key from the tree
+     *
+     *	@param[in]	name        Name of the key
+     *	@return bool
+     */
+    bool erase( const std::string_view &name );
+
+    /**
+     *	Invokes func( uint16_t slot ) for every key at or below a namespace.
+     *  An empty namespace visits every key in the tree.
+     *
+     *	@param[in]	prefix      The namespace, ie "nav.ekf"
+     *	@param[in]	func        Visitor
+     *	@return void
+     */
+    template<typename Func>
+    void forEachUnder( const std::string_view &prefix, Func &&func ) const
+    {
+      const uint32_t start = locate( prefix );
+      if ( start == NONE )
+      {
+        return;
+      }
+
+      /*------------------------------------------------
+      Depth first walk of the subtree without a stack
+      ------------------------------------------------*/
+      uint32_t node = start;
+
+      while ( node != NONE )
+      {
+        if ( nodes[ node ].slot != INVALID_SLOT )
+        {
+          func( nodes[ node ].slot );
+        }
+
+        if ( nodes[ node ].firstChild != NONE )
+        {
+          node = nodes[ node ].firstChild;
+          continue;
+        }
+
+        while ( ( node != start ) && ( nodes[ node ].nextSibling == NONE ) )
+        {
+          node = nodes[ node ].parent;
+        }
+
+        node = ( node == start ) ? NONE : nodes[ node ].nextSibling;
+      }
+    }
+
+  private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    struct Node
+    {
+      std::string_view segment;
+      uint32_t parent;
+      uint32_t firstChild;
+      uint32_t nextSibling;
+      uint16_t slot;
+    };
+
+    std::vector<Node> nodes;
+
+    uint32_t findChild( const uint32_t parent, const std::string_view &segment ) const;
+
+    /**
+     *  Finds the node for a full name or namespace, NONE if it doesn't exist
+     */
+    uint32_t locate( const std::string_view &name ) const;
+  };
+
+  /**
+   *  Registry index selected for the Manager
+   */
+#if defined( AERO_KERNEL_PARAMETER_FLAT_MAP )
+  using IndexMap = FlatMap;
+#else
+  using IndexMap = SparseMap;
+#endif
+
+  /**
+   *  Minimal perfect hash over a fixed set of keys, built with the CHD
+   *  (compress, hash and displace) algorithm. Keys are first hashed into
+   *  small buckets, then each bucket is assigned a displacement that places
+   *  all of its keys into unused positions of a table exactly as large as the
+   *  key set. A lookup is therefore one hash, one table access and one key
+   *  comparison, with no probing.
+   *
+   *  The structure is immutable once built, so concurrent lookups are safe
+   *  without any locking.
+   */
+  class PerfectHash
+  {
+  public:
+    PerfectHash();
+    ~PerfectHash() = default;
+
+    /**
+     *	Builds the hash over the given key set, replacing any previous contents
+     *
+     *	@param[in]	entries     Every key to be indexed along with its slot
+     *	@return bool            False if no perfect hash could be found, ie two keys share a hash
+     */
+    bool build( const std::vector<std::pair<Key, uint16_t>> &entries );
+
+    /**
+     *	Removes all keys
+     *
+     *	@return void
+     */
+    void clear();
+
+    /**
+     *	Looks up the slot associated with a key
+     *
+     *	@param[in]	key         The parameter's name
+     *	@return uint16_t        The slot, or INVALID_SLOT if the key was not part of the set
+     */
+    uint16_t find( const Key &key ) const
+    {
+      uint16_t result = INVALID_SLOT;
+
+      if ( !table.empty() )
+      {
+        const uint32_t mixed  = key.getHash() ^ seed;
+        const uint32_t bucket = reduce( mixHash( mixed ), static_cast<uint32_t>( displacement.size() ) );
+        const Entry &entry    = table[ position( mixed, displacement[ bucket ] ) ];
+
+        if ( entry.key == key )
+        {
+          result = entry.slot;
+        }
+      }
+
+      return result;
+    }
+
+    /**
+     *	Gets the number of keys in the hash
+     *
+     *	@return size_t
+     */
+    size_t size() const
+    {
+      return table.size();
+    }
+
+  private:
+    struct Entry
+    {
+      Key key;
+      uint16_t slot = INVALID_SLOT;
+    };
+
+    uint32_t seed;
+    std::vector<uint16_t> displacement;
+    std::vector<Entry> table;
+
+    /**
+     *  Maps a 32-bit value onto [0, range) without a division
+     */
+    static constexpr uint32_t reduce( const uint32_t x, const uint32_t range )
+    {
+      return static_cast<uint32_t>( ( static_cast<uint64_t>( x ) * range ) >> 32 );
+    }
+
+    uint32_t position( const uint32_t mixed, const uint16_t disp ) const
+    {
+      return reduce( mixHash( mixed + ( static_cast<uint32_t>( disp ) + 1u ) * 0x9E3779B9u ),
+                     static_cast<uint32_t>( table.size() ) );
+    }
+  };
+
+}  // namespace AeroKernel::Parameter
+
+#endif /* !AERO_KERNEL_PARAMETER_INDEX_HPP */
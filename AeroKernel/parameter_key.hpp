@@ -0,0 +1,147 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_key.hpp
+ *
+ *  Description:
+ *    Parameter name type used by the AeroKernel Parameter Manager. Keys carry a
+ *    pre-computed hash so that lookups with compile time constant names never
+ *    need to hash anything at runtime.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef AERO_KERNEL_PARAMETER_KEY_HPP
+#define AERO_KERNEL_PARAMETER_KEY_HPP
+
+/* C++ Includes */
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace AeroKernel::Parameter
+{
+  /**
+   *  A parameter name paired with its pre-computed hash. Keys built in a
+   *  constant expression, such as those produced by the _pkey literal, have
+   *  their hash calculated at compile time so the Manager never has to walk
+   *  the characters of the name until the final equality check.
+   *
+   *  The referenced characters are not owned by the key and must outlive it.
+   */
+  class Key
+  {
+  public:
+    constexpr Key() : name(), hash( hashOf( std::string_view() ) )
+    {
+    }
+
+    constexpr explicit Key( const std::string_view &name ) : name( name ), hash( hashOf( name ) )
+    {
+    }
+
+    /**
+     *	Gets the name this key was constructed from
+     *
+     *	@return const std::string_view &
+     */
+    constexpr const std::string_view &view() const
+    {
+      return name;
+    }
+
+    /**
+     *	Gets the pre-computed hash of the key's name
+     *
+     *	@return uint32_t
+     */
+    constexpr uint32_t getHash() const
+    {
+      return hash;
+    }
+
+    constexpr bool operator==( const Key &rhs ) const
+    {
+      return ( hash == rhs.hash ) && sameName( name, rhs.name );
+    }
+
+    constexpr bool operator!=( const Key &rhs ) const
+    {
+      return !( *this == rhs );
+    }
+
+    /**
+     *	Compares two names, short-circuiting when both views reference the same
+     *  characters. This makes comparisons against the Manager's interned copy
+     *  of a key a simple pointer check.
+     *
+     *	@param[in]	lhs       First name
+     *	@param[in]	rhs       Second name
+     *	@return bool
+     */
+    static constexpr bool sameName( const std::string_view &lhs, const std::string_view &rhs )
+    {
+      return ( lhs.size() == rhs.size() ) && ( ( lhs.data() == rhs.data() ) || ( lhs == rhs ) );
+    }
+
+    /**
+     *	Computes the 32-bit FNV-1a hash of a parameter name. The algorithm is
+     *  fixed so that hashes are identical across host and target builds.
+     *
+     *	@param[in]	name      The parameter's name
+     *	@return uint32_t
+     */
+    static constexpr uint32_t hashOf( const std::string_view &name )
+    {
+      uint32_t result = 2166136261u;
+
+      for ( const char c : name )
+      {
+        result ^= static_cast<uint8_t>( c );
+        result *= 16777619u;
+      }
+
+      return result;
+    }
+
+  private:
+    friend class KeyArena;
+    friend class FlatMap;
+
+    /**
+     *  Pairs a name with an already known hash, used when relocating a key
+     *  or handing out one already stored in an index
+     */
+    constexpr Key( const std::string_view &name, const uint32_t hash ) : name( name ), hash( hash )
+    {
+    }
+
+    std::string_view name;
+    uint32_t hash;
+  };
+
+  /**
+   *  Hash functor that simply forwards the pre-computed key hash
+   */
+  struct KeyHasher
+  {
+    size_t operator()( const Key &key ) const
+    {
+      return static_cast<size_t>( key.getHash() );
+    }
+  };
+
+  inline namespace Literals
+  {
+    /**
+     *  Creates a compile time hashed parameter key, ie "ahrs.gyro"_pkey
+     */
+    constexpr Key operator""_pkey( const char *str, const size_t len )
+    {
+      return Key( std::string_view( str, len ) );
+    }
+  }  // namespace Literals
+
+}  // namespace AeroKernel::Parameter
+
+#endif /* !AERO_KERNEL_PARAMETER_KEY_HPP */
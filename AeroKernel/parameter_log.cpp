@@ -0,0 +1,395 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_log.cpp
+ *
+ *  Description:
+ *    Implements the log structured parameter store.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <cstddef>
+#include <cstring>
+
+#include <AeroKernel/parameter_log.hpp>
+
+namespace AeroKernel::Parameter
+{
+  LogStore::LogStore() : baseAddress( 0 ), sectorSize( 0 ), head( 0 ), tail( 0 ), nextSequence( 0 )
+  {
+  }
+
+  bool LogStore::mount( const Chimera::Modules::Memory::Device_sPtr &driver,
+                        const Chimera::Modules::Memory::Descriptor &specs )
+  {
+    bool result = false;
+
+    if ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK )
+    {
+      /*------------------------------------------------
+      The log needs room for the active sector plus the reserve, and every
+      sector must be able to hold the largest record.
+      ------------------------------------------------*/
+      const size_t regionSize = ( specs.endAddress >= specs.startAddress ) ? ( specs.endAddress - specs.startAddress + 1u ) : 0u;
+      const size_t numSectors = specs.sectorSize ? ( regionSize / specs.sectorSize ) : 0u;
+
+      device       = driver;
+      baseAddress  = specs.startAddress;
+      sectorSize   = specs.sectorSize;
+      head         = 0;
+      tail         = 0;
+      nextSequence = 0;
+
+      sectors.assign( numSectors, Sector{ 0, 0 } );
+      scratch.assign( recordSize( MAX_RECORD_NAME, MAX_RECORD_DATA ), 0xFF );
+      index.clear();
+      names.init( sectorSize );
+
+      result = device && ( numSectors > RESERVE_SECTORS ) && ( sectorSize >= recordSize( MAX_RECORD_NAME, MAX_RECORD_DATA ) );
+
+      bool found             = false;
+      uint32_t newest        = 0;
+      uint32_t oldestInitial = ERASED;
+
+      for ( size_t sector = 0; result && ( sector < numSectors ); sector++ )
+      {
+        size_t offset = 0;
+        bool valid    = true;
+
+        while ( ( offset + sizeof( RecordHeader ) ) <= sectorSize )
+        {
+          const size_t address = ( sector * sectorSize ) + offset;
+          RecordHeader header;
+
+          if ( device->read( baseAddress + address, reinterpret_cast<uint8_t *>( &header ), sizeof( header ) )
+               != Chimera::CommonStatusCodes::OK )
+          {
+            valid = false;
+            break;
+          }
+
+          /*------------------------------------------------
+          Erased memory marks the end of the sector's records
+          ------------------------------------------------*/
+          if ( ( header.sequence == ERASED ) && ( header.hash == ERASED ) && ( header.size == 0xFFFF )
+               && ( header.nameLength == 0xFFFF ) && ( header.checksum == 0xFFFF ) )
+          {
+            break;
+          }
+
+          const size_t total  = recordSize( header.nameLength, header.size );
+          uint8_t *const body = scratch.data() + sizeof( RecordHeader );
+
+          if ( ( header.size > MAX_RECORD_DATA ) || ( header.nameLength > MAX_RECORD_NAME ) || ( ( offset + total ) > sectorSize )
+               || ( device->read( baseAddress + address + sizeof( header ), body, header.nameLength + header.size )
+                    != Chimera::CommonStatusCodes::OK )
+               || ( checksum( header, body ) != header.checksum ) )
+          {
+            valid = false;
+            break;
+          }
+
+          const Key key( std::string_view( reinterpret_cast<const char *>( body ), header.nameLength ) );
+
+          if ( key.getHash() != header.hash )
+          {
+            valid = false;
+            break;
+          }
+
+          /*------------------------------------------------
+          Keep the newest record of each parameter, telling parameters
+          apart by name rather than by hash
+          ------------------------------------------------*/
+          auto iter         = index.find( key );
+          const Entry entry = Entry{ static_cast<uint32_t>( address ), header.sequence, header.size };
+
+          if ( iter == index.end() )
+          {
+            index.insert( { names.intern( key ), entry } );
+            sectors[ sector ].live += static_cast<uint32_t>( total );
+          }
+          else if ( header.sequence > iter->second.sequence )
+          {
+            sectors[ iter->second.offset / sectorSize ].live -=
+                static_cast<uint32_t>( recordSize( iter->first.view().size(), iter->second.size ) );
+
+            iter->second = entry;
+            sectors[ sector ].live += static_cast<uint32_t>( total );
+          }
+
+          if ( ( offset == 0u ) && ( header.sequence < oldestInitial ) )
+          {
+            oldestInitial = header.sequence;
+            tail          = sector;
+          }
+
+          if ( !found || ( header.sequence > newest ) )
+          {
+            found  = true;
+            newest = header.sequence;
+            head   = sector;
+          }
+
+          offset += total;
+          sectors[ sector ].used = static_cast<uint32_t>( offset );
+        }
+
+        /*------------------------------------------------
+        A sector that doesn't start with a valid record is garbage. One that
+        ends in a torn record is sealed so nothing is programmed over it.
+        ------------------------------------------------*/
+        if ( !valid && ( sectors[ sector ].used == 0u ) )
+        {
+          result = eraseSector( sector );
+        }
+        else if ( !valid )
+        {
+          sectors[ sector ].used = static_cast<uint32_t>( sectorSize );
+        }
+      }
+
+      if ( !found )
+      {
+        head = 0;
+        tail = 0;
+      }
+
+      nextSequence = found ? ( newest + 1u ) : 0u;
+
+      release();
+    }
+
+    return result;
+  }
+
+  bool LogStore::read( const Key &key, void *const data, const size_t size )
+  {
+    bool result = false;
+
+    if ( device && ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      auto iter = index.find( key );
+
+      if ( ( iter != index.end() ) && ( iter->second.size == size ) )
+      {
+        Chimera::Status_t error = device->read( baseAddress + iter->second.offset + sizeof( RecordHeader ) + key.view().size(),
+                                                reinterpret_cast<uint8_t *>( data ), size );
+        result = ( error == Chimera::CommonStatusCodes::OK );
+      }
+
+      release();
+    }
+
+    return result;
+  }
+
+  bool LogStore::write( const Key &key, const void *const data, const size_t size )
+  {
+    bool result = false;
+
+    if ( device && ( size <= MAX_RECORD_DATA ) && ( key.view().size() <= MAX_RECORD_NAME )
+         && ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      /*------------------------------------------------
+      Restore the reserve before appending. Each step frees at most one
+      sector, so give up once every sector has been tried.
+      ------------------------------------------------*/
+      for ( size_t x = 0; ( x < sectors.size() ) && ( freeSectors() < RESERVE_SECTORS ); x++ )
+      {
+        if ( !compactTail() )
+        {
+          break;
+        }
+      }
+
+      memcpy( scratch.data() + sizeof( RecordHeader ) + key.view().size(), data, size );
+      result = append( key, size );
+
+      release();
+    }
+
+    return result;
+  }
+
+  bool LogStore::collect()
+  {
+    bool result = false;
+
+    if ( device && ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      result = compactTail();
+      release();
+    }
+
+    return result;
+  }
+
+  size_t LogStore::freeSectors() const
+  {
+    size_t result = 0;
+
+    if ( !sectors.empty() )
+    {
+      result = sectors.size() - ( ( ( head + sectors.size() - tail ) % sectors.size() ) + 1u );
+    }
+
+    return result;
+  }
+
+  uint16_t LogStore::checksum( const RecordHeader &header, const uint8_t *const body )
+  {
+    uint32_t sum1 = 0;
+    uint32_t sum2 = 0;
+
+    auto accumulate = [ &sum1, &sum2 ]( const uint8_t *const bytes, const size_t length ) {
+      for ( size_t x = 0; x < length; x++ )
+      {
+        sum1 = ( sum1 + bytes[ x ] ) % 255u;
+        sum2 = ( sum2 + sum1 ) % 255u;
+      }
+    };
+
+    accumulate( reinterpret_cast<const uint8_t *>( &header ), offsetof( RecordHeader, checksum ) );
+    accumulate( body, header.nameLength + header.size );
+
+    return static_cast<uint16_t>( ( sum2 << 8 ) | sum1 );
+  }
+
+  size_t LogStore::recordSize( const size_t nameLength, const size_t dataSize )
+  {
+    return ( sizeof( RecordHeader ) + nameLength + dataSize + RECORD_ALIGNMENT - 1u ) & ~( RECORD_ALIGNMENT - 1u );
+  }
+
+  bool LogStore::append( const Key &key, const size_t size )
+  {
+    bool result             = false;
+    const size_t nameLength = key.view().size();
+    const size_t total      = recordSize( nameLength, size );
+
+    /*------------------------------------------------
+    Move on to the next erased sector if the record doesn't fit
+    ------------------------------------------------*/
+    if ( ( sectors[ head ].used + total ) > sectorSize )
+    {
+      if ( freeSectors() == 0u )
+      {
+        return false;
+      }
+
+      head = ( head + 1u ) % sectors.size();
+    }
+
+    /*------------------------------------------------
+    The data is already in place behind the name. The name may be the
+    copy being relocated by compaction, in which case it is already there.
+    ------------------------------------------------*/
+    uint8_t *const body = scratch.data() + sizeof( RecordHeader );
+
+    if ( reinterpret_cast<const uint8_t *>( key.view().data() ) != body )
+    {
+      memcpy( body, key.view().data(), nameLength );
+    }
+
+    RecordHeader header;
+    header.sequence   = nextSequence;
+    header.hash       = key.getHash();
+    header.size       = static_cast<uint16_t>( size );
+    header.nameLength = static_cast<uint16_t>( nameLength );
+    header.checksum   = checksum( header, body );
+    header.reserved   = 0xFFFF;
+
+    memcpy( scratch.data(), &header, sizeof( header ) );
+    memset( body + nameLength + size, 0xFF, total - sizeof( header ) - nameLength - size );
+
+    const uint32_t offset = static_cast<uint32_t>( ( head * sectorSize ) + sectors[ head ].used );
+    result = ( device->write( baseAddress + offset, scratch.data(), total ) == Chimera::CommonStatusCodes::OK );
+
+    /*------------------------------------------------
+    A failed program may still have touched the flash, so the space is
+    consumed either way. Only a successful record supersedes the old one.
+    ------------------------------------------------*/
+    sectors[ head ].used += static_cast<uint32_t>( total );
+
+    if ( result )
+    {
+      auto iter         = index.find( key );
+      const Entry entry = Entry{ offset, nextSequence, static_cast<uint32_t>( size ) };
+
+      if ( iter != index.end() )
+      {
+        sectors[ iter->second.offset / sectorSize ].live -= static_cast<uint32_t>( recordSize( nameLength, iter->second.size ) );
+        iter->second = entry;
+      }
+      else
+      {
+        index.insert( { names.intern( key ), entry } );
+      }
+
+      sectors[ head ].live += static_cast<uint32_t>( total );
+      nextSequence++;
+    }
+
+    return result;
+  }
+
+  bool LogStore::compactTail()
+  {
+    bool result = ( tail != head );
+
+    /*------------------------------------------------
+    Walk the sector, moving every record that is still the latest
+    value of its parameter to the head of the log
+    ------------------------------------------------*/
+    const size_t base = tail * sectorSize;
+    size_t offset     = 0;
+
+    while ( result && ( sectors[ tail ].live > 0u ) && ( ( offset + sizeof( RecordHeader ) ) <= sectors[ tail ].used ) )
+    {
+      RecordHeader header;
+      uint8_t *const body = scratch.data() + sizeof( RecordHeader );
+
+      result = ( device->read( baseAddress + base + offset, reinterpret_cast<uint8_t *>( &header ), sizeof( header ) )
+                 == Chimera::CommonStatusCodes::OK )
+               && ( header.nameLength <= MAX_RECORD_NAME ) && ( header.size <= MAX_RECORD_DATA )
+               && ( device->read( baseAddress + base + offset + sizeof( header ), body, header.nameLength + header.size )
+                    == Chimera::CommonStatusCodes::OK );
+
+      if ( result )
+      {
+        const Key key( std::string_view( reinterpret_cast<const char *>( body ), header.nameLength ) );
+        auto iter = index.find( key );
+
+        if ( ( iter != index.end() ) && ( iter->second.offset == ( base + offset ) ) )
+        {
+          result = append( key, header.size );
+        }
+
+        offset += recordSize( header.nameLength, header.size );
+      }
+    }
+
+    /*------------------------------------------------
+    Only retire the sector once it is actually erased, otherwise it is
+    retried by the next collection
+    ------------------------------------------------*/
+    if ( result && ( ( sectors[ tail ].used == 0u ) || eraseSector( tail ) ) )
+    {
+      sectors[ tail ] = Sector{ 0, 0 };
+      tail            = ( tail + 1u ) % sectors.size();
+    }
+    else
+    {
+      result = false;
+    }
+
+    return result;
+  }
+
+  bool LogStore::eraseSector( const size_t sector )
+  {
+    return device->erase( baseAddress + ( sector * sectorSize ), sectorSize ) == Chimera::CommonStatusCodes::OK;
+  }
+
+}  // namespace AeroKernel::Parameter
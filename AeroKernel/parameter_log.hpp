@@ -0,0 +1,181 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_log.hpp
+ *
+ *  Description:
+ *    Log structured parameter storage for flash devices. Instead of rewriting a
+ *    parameter in place, which costs a sector erase on every update, each write
+ *    appends a new record to the end of a circular log of sectors. An in-RAM
+ *    index tracks the latest record of every parameter, and the oldest sector
+ *    is compacted and erased once free space runs low, which spreads wear over
+ *    the whole region.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef AERO_KERNEL_PARAMETER_LOG_HPP
+#define AERO_KERNEL_PARAMETER_LOG_HPP
+
+/* C++ Includes */
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/* Hash Map Include */
+#include <sparsepp/spp.h>
+
+/* AeroKernel Includes */
+#include <AeroKernel/parameter_index.hpp>
+#include <AeroKernel/parameter_key.hpp>
+
+/* Chimera Includes */
+#include <Chimera/modules/memory/device.hpp>
+#include <Chimera/threading.hpp>
+
+namespace AeroKernel::Parameter
+{
+  /**
+   *  A circular, append only log of parameter records kept in the region of a
+   *  memory device described by a Descriptor. Records carry the parameter's
+   *  full name, so keys with colliding hashes never overwrite one another,
+   *  and a sequence number, so the latest value can be recovered by scanning
+   *  the region at mount.
+   *
+   *  Layout:
+   *    The region is split into sectors that are filled in order. A record is
+   *    a header followed by the name and then the data, and never straddles
+   *    a sector, and the unused tail of a sector is left
+   *    erased. At least RESERVE_SECTORS erased sectors are kept ahead of the
+   *    write position so that the oldest sector can always be compacted.
+   */
+  class LogStore : public Chimera::Threading::Lockable
+  {
+  public:
+    static constexpr size_t MAX_RECORD_DATA  = 256; /**< Largest parameter that can be stored */
+    static constexpr size_t MAX_RECORD_NAME  = 128; /**< Longest key name that can be stored */
+    static constexpr size_t RECORD_ALIGNMENT = 4;   /**< Programming granularity of a record */
+    static constexpr size_t RESERVE_SECTORS  = 2;   /**< Erased sectors kept free for compaction */
+
+    LogStore();
+    ~LogStore() = default;
+
+    /**
+     *	Scans the region for records and rebuilds the index. Sectors that do
+     *  not start with a valid record are treated as garbage and erased, so a
+     *  blank or foreign region is formatted on first use.
+     *
+     *	@param[in]	driver      Driver for the memory holding the log
+     *	@param[in]	specs       Region of the device reserved for the log
+     *	@return bool
+     */
+    bool mount( const Chimera::Modules::Memory::Device_sPtr &driver, const Chimera::Modules::Memory::Descriptor &specs );
+
+    /**
+     *	Reads the latest value of a parameter
+     *
+     *	@param[in]	key         The parameter's key
+     *	@param[out]	data        Where to place the value
+     *	@param[in]	size        Size of the value, which must match the stored record
+     *	@return bool            False if the parameter has never been written
+     */
+    bool read( const Key &key, void *const data, const size_t size );
+
+    /**
+     *	Appends a new value of a parameter, compacting old sectors first if the
+     *  log is running out of erased sectors.
+     *
+     *	@param[in]	key         The parameter's key
+     *	@param[in]	data        The value to store
+     *	@param[in]	size        Size of the value
+     *	@return bool            False if the name or value is too large, or the log is full
+     */
+    bool write( const Key &key, const void *const data, const size_t size );
+
+    /**
+     *	Performs one incremental garbage collection step by relocating the live
+     *  records out of the oldest sector and erasing it. Writes collect on their
+     *  own when needed, but calling this from an idle task keeps that work off
+     *  the write path.
+     *
+     *	@return bool            False if there was nothing to collect
+     */
+    bool collect();
+
+    /**
+     *	Number of sectors that are fully erased and ready to be written
+     *
+     *	@return size_t
+     */
+    size_t freeSectors() const;
+
+  private:
+    struct RecordHeader
+    {
+      uint32_t sequence;   /**< Ordering of the record, all ones marks erased memory */
+      uint32_t hash;       /**< Key hash of the parameter */
+      uint16_t size;       /**< Size of the data following the name */
+      uint16_t nameLength; /**< Size of the name following the header */
+      uint16_t checksum;   /**< Fletcher-16 over the header fields, name and data */
+      uint16_t reserved;   /**< Left erased */
+    };
+
+    struct Entry
+    {
+      uint32_t offset;   /**< Offset of the latest record from the start of the region */
+      uint32_t sequence; /**< Sequence number of the latest record */
+      uint32_t size;     /**< Size of the record's data */
+    };
+
+    struct Sector
+    {
+      uint32_t used; /**< Bytes consumed by records, including dead ones */
+      uint32_t live; /**< Bytes of records that are still the latest value */
+    };
+
+    static constexpr uint32_t ERASED        = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t LOCK_TIMEOUT_MS = 100;
+
+    Chimera::Modules::Memory::Device_sPtr device;
+    size_t baseAddress;
+    size_t sectorSize;
+    size_t head;
+    size_t tail;
+    uint32_t nextSequence;
+    std::vector<Sector> sectors;
+    std::vector<uint8_t> scratch;
+    KeyArena names; /**< Owns the names referenced by the index */
+    spp::sparse_hash_map<Key, Entry, KeyHasher> index;
+
+    /**
+     *	Computes the checksum of a record
+     *
+     *	@param[in]	header      The record's header
+     *	@param[in]	body        The name immediately followed by the data
+     *	@return uint16_t
+     */
+    static uint16_t checksum( const RecordHeader &header, const uint8_t *const body );
+
+    static size_t recordSize( const size_t nameLength, const size_t dataSize );
+
+    /**
+     *	Programs the record staged in the scratch buffer at the write position
+     *
+     *	@param[in]	key         The parameter's key
+     *	@param[in]	size        Size of the data already copied in after the name
+     *	@return bool
+     */
+    bool append( const Key &key, const size_t size );
+
+    /**
+     *	Relocates the live records of the oldest sector and erases it
+     *
+     *	@return bool            False if the oldest sector is the active one, or a transfer failed
+     */
+    bool compactTail();
+
+    bool eraseSector( const size_t sector );
+  };
+}  // namespace AeroKernel::Parameter
+
+#endif /* !AERO_KERNEL_PARAMETER_LOG_HPP */
@@ -0,0 +1,68 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_mailbox.cpp
+ *
+ *  Description:
+ *    Implements the triple buffered parameter mailbox.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <cstring>
+
+#include <AeroKernel/parameter_mailbox.hpp>
+
+namespace AeroKernel::Parameter
+{
+  Mailbox::Mailbox( const size_t size ) : length( size ), buffers( new uint8_t[ BUFFERS * size ]() ), latest( 0 )
+  {
+    for ( auto &sequence : sequences )
+    {
+      sequence = 0u;
+    }
+  }
+
+  void Mailbox::publish( const void *const data )
+  {
+    /*------------------------------------------------
+    Only the producer changes latest, so it can't move underneath us
+    ------------------------------------------------*/
+    const uint32_t next = ( latest.load( std::memory_order_relaxed ) + 1u ) % BUFFERS;
+
+    sequences[ next ].fetch_add( 1u, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    memcpy( buffers.get() + ( next * length ), data, length );
+
+    sequences[ next ].fetch_add( 1u, std::memory_order_release );
+    latest.store( next, std::memory_order_release );
+  }
+
+  void Mailbox::fetch( void *const data ) const
+  {
+    uint32_t index    = 0;
+    uint32_t sequence = 0;
+    bool copied       = false;
+
+    do
+    {
+      index    = latest.load( std::memory_order_acquire );
+      sequence = sequences[ index ].load( std::memory_order_acquire );
+
+      /*------------------------------------------------
+      A consumer stalled long enough can find its buffer refilled with a
+      sample that isn't the latest yet. Copying that would let a later fetch
+      return an older sample, so only copy while the buffer is still latest.
+      ------------------------------------------------*/
+      copied = !( sequence & 1u ) && ( latest.load( std::memory_order_acquire ) == index );
+
+      if ( copied )
+      {
+        memcpy( data, buffers.get() + ( index * length ), length );
+        std::atomic_thread_fence( std::memory_order_acquire );
+        copied = ( sequences[ index ].load( std::memory_order_relaxed ) == sequence );
+      }
+    } while ( !copied );
+  }
+}  // namespace AeroKernel::Parameter
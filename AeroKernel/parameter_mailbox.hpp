@@ -0,0 +1,122 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_mailbox.hpp
+ *
+ *  Description:
+ *    Triple buffered storage for parameters that carry a stream of samples,
+ *    such as sensor data, from one producer to any number of consumers. Only
+ *    the newest sample matters, so the producer never waits for a consumer to
+ *    finish and a consumer never waits for the producer.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef AERO_KERNEL_PARAMETER_MAILBOX_HPP
+#define AERO_KERNEL_PARAMETER_MAILBOX_HPP
+
+/* C++ Includes */
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace AeroKernel::Parameter
+{
+  /**
+   *  Latest value mailbox built on three buffers. The producer always fills
+   *  the buffer published two samples ago, leaving the newest and the one
+   *  before it alone for consumers still copying them. Each buffer carries a
+   *  sequence count, so the rare consumer that is lapped twice mid-copy sees
+   *  the count change and simply copies the newest sample instead. A buffer
+   *  is only copied while it is the latest, so successive fetches never go
+   *  back to an older sample.
+   *
+   *  Only one task may publish to a mailbox at a time. Any number of tasks may
+   *  fetch from it. Neither takes a lock.
+   */
+  class Mailbox
+  {
+  public:
+    static constexpr size_t BUFFERS = 3;
+
+    /**
+     *	Allocates the buffers, which start out holding a zeroed sample
+     *
+     *	@param[in]	size        Size of a sample in bytes
+     */
+    explicit Mailbox( const size_t size );
+    ~Mailbox() = default;
+
+    Mailbox( const Mailbox & ) = delete;
+    Mailbox &operator=( const Mailbox & ) = delete;
+
+    /**
+     *	Makes a new sample the one consumers fetch
+     *
+     *	@param[in]	data        The sample, which must be size() bytes
+     *	@return void
+     */
+    void publish( const void *const data );
+
+    /**
+     *	Copies out the newest complete sample
+     *
+     *	@param[out]	data        Where to place the sample, which must hold size() bytes
+     *	@return void
+     */
+    void fetch( void *const data ) const;
+
+    /**
+     *	Type safe versions of publish() and fetch()
+     *
+     *	@return bool            False if the size of T doesn't match the mailbox
+     */
+    template<typename T>
+    bool publish( const T &value )
+    {
+      static_assert( std::is_trivially_copyable_v<T>, "Samples are transferred as raw bytes" );
+      const bool result = ( sizeof( T ) == length );
+
+      if ( result )
+      {
+        publish( static_cast<const void *>( &value ) );
+      }
+
+      return result;
+    }
+
+    template<typename T>
+    bool fetch( T &value ) const
+    {
+      static_assert( std::is_trivially_copyable_v<T>, "Samples are transferred as raw bytes" );
+      const bool result = ( sizeof( T ) == length );
+
+      if ( result )
+      {
+        fetch( static_cast<void *>( &value ) );
+      }
+
+      return result;
+    }
+
+    /**
+     *	Gets the size of a sample in bytes
+     *
+     *	@return size_t
+     */
+    size_t size() const
+    {
+      return length;
+    }
+
+  private:
+    const size_t length;
+    std::unique_ptr<uint8_t[]> buffers;
+    std::atomic<uint32_t> latest;                          /**< Buffer holding the newest complete sample */
+    std::array<std::atomic<uint32_t>, BUFFERS> sequences; /**< Odd while a buffer is being filled */
+  };
+}  // namespace AeroKernel::Parameter
+
+#endif /* !AERO_KERNEL_PARAMETER_MAILBOX_HPP */
@@ -0,0 +1,288 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_sim.cpp
+ *
+ *  Description:
+ *    Implements the simulated memory device used to benchmark the Parameter
+ *    Manager on a host.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#include <AeroKernel/parameter_sim.hpp>
+
+#if defined( __unix__ )
+
+/* C++ Includes */
+#include <algorithm>
+#include <cstring>
+
+/* POSIX Includes */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace AeroKernel::Parameter
+{
+  LatencyModel LatencyModel::forStorage( const StorageType storage )
+  {
+    LatencyModel result;
+
+    switch ( storage )
+    {
+      case StorageType::INTERNAL_FLASH:
+        result = internalFlash();
+        break;
+
+      case StorageType::EXTERNAL_FLASH0:
+      case StorageType::EXTERNAL_FLASH1:
+      case StorageType::EXTERNAL_FLASH2:
+        result = qspiNor();
+        break;
+
+      case StorageType::EXTERNAL_SRAM0:
+      case StorageType::EXTERNAL_SRAM1:
+      case StorageType::EXTERNAL_SRAM2:
+        /*------------------------------------------------
+        16-bit asynchronous SRAM on the external memory controller
+        ------------------------------------------------*/
+        result               = sram();
+        result.transactionNs = 60;
+        result.readByteNs    = 30;
+        result.writeByteNs   = 30;
+        break;
+
+      default:
+        result = sram();
+        break;
+    };
+
+    return result;
+  }
+
+  SimulatedDevice::SimulatedDevice( const LatencyModel &model ) :
+      model( model ), counters(), memory( nullptr ), memorySize( 0 ), file( -1 )
+  {
+  }
+
+  SimulatedDevice::~SimulatedDevice()
+  {
+    close();
+  }
+
+  bool SimulatedDevice::open( const size_t size )
+  {
+    close();
+
+    void *mapping = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+
+    if ( size && ( mapping != MAP_FAILED ) )
+    {
+      memory     = reinterpret_cast<uint8_t *>( mapping );
+      memorySize = size;
+      memset( memory, ERASED, memorySize );
+    }
+
+    return memory != nullptr;
+  }
+
+  bool SimulatedDevice::open( const std::string &path, const size_t size )
+  {
+    close();
+
+    struct stat info;
+    file = ::open( path.c_str(), O_RDWR | O_CREAT, 0644 );
+
+    if ( size && ( file >= 0 ) && ( fstat( file, &info ) == 0 ) )
+    {
+      /*------------------------------------------------
+      A new or grown file is extended with zeros, which are then erased.
+      Existing contents are kept, as they are the memory's previous state.
+      ------------------------------------------------*/
+      const size_t existing = static_cast<size_t>( info.st_size );
+      bool sized            = ( existing >= size ) || ( ftruncate( file, static_cast<off_t>( size ) ) == 0 );
+      void *mapping         = sized ? mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0 ) : MAP_FAILED;
+
+      if ( mapping != MAP_FAILED )
+      {
+        memory     = reinterpret_cast<uint8_t *>( mapping );
+        memorySize = size;
+
+        if ( existing < size )
+        {
+          memset( memory + existing, ERASED, size - existing );
+        }
+      }
+    }
+
+    if ( !memory )
+    {
+      close();
+    }
+
+    return memory != nullptr;
+  }
+
+  void SimulatedDevice::close()
+  {
+    if ( memory )
+    {
+      if ( file >= 0 )
+      {
+        msync( memory, memorySize, MS_SYNC );
+      }
+
+      munmap( memory, memorySize );
+    }
+
+    if ( file >= 0 )
+    {
+      ::close( file );
+    }
+
+    memory     = nullptr;
+    memorySize = 0;
+    file       = -1;
+  }
+
+  Chimera::Status_t SimulatedDevice::write( const size_t address, const uint8_t *const data, const size_t length )
+  {
+    Chimera::Status_t result = Chimera::CommonStatusCodes::FAIL;
+
+    if ( data && memory && ( address <= memorySize ) && ( length <= ( memorySize - address ) )
+         && ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      uint8_t *const dest = memory + address;
+      bool unerased       = false;
+
+      if ( model.flash )
+      {
+        /*------------------------------------------------
+        Programming can only pull bits low
+        ------------------------------------------------*/
+        for ( size_t x = 0; x < length; x++ )
+        {
+          unerased |= ( ( dest[ x ] & data[ x ] ) != data[ x ] );
+          dest[ x ] &= data[ x ];
+        }
+      }
+      else
+      {
+        memcpy( dest, data, length );
+      }
+
+      const size_t pages = unitsTouched( address, length, model.programSize );
+
+      counters.writes++;
+      counters.bytesWritten += length;
+      counters.pagesProgrammed += pages;
+      counters.unerasedWrites += unerased ? 1u : 0u;
+      counters.elapsedNs += model.transactionNs + ( static_cast<uint64_t>( model.writeByteNs ) * length )
+                            + ( static_cast<uint64_t>( model.programNs ) * pages );
+
+      release();
+      result = Chimera::CommonStatusCodes::OK;
+    }
+
+    return result;
+  }
+
+  Chimera::Status_t SimulatedDevice::read( const size_t address, uint8_t *const data, const size_t length )
+  {
+    Chimera::Status_t result = Chimera::CommonStatusCodes::FAIL;
+
+    if ( data && memory && ( address <= memorySize ) && ( length <= ( memorySize - address ) )
+         && ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      memcpy( data, memory + address, length );
+
+      counters.reads++;
+      counters.bytesRead += length;
+      counters.elapsedNs += model.transactionNs + ( static_cast<uint64_t>( model.readByteNs ) * length );
+
+      release();
+      result = Chimera::CommonStatusCodes::OK;
+    }
+
+    return result;
+  }
+
+  Chimera::Status_t SimulatedDevice::erase( const size_t address, const size_t length )
+  {
+    Chimera::Status_t result = Chimera::CommonStatusCodes::FAIL;
+
+    if ( memory && ( address <= memorySize ) && ( length <= ( memorySize - address ) )
+         && ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK ) )
+    {
+      size_t start = address;
+      size_t end   = address + length;
+
+      /*------------------------------------------------
+      Sectors are erased whole, taking their neighbors' data with them
+      ------------------------------------------------*/
+      if ( model.sectorSize && length )
+      {
+        start = ( start / model.sectorSize ) * model.sectorSize;
+        end   = std::min( memorySize, ( ( end + model.sectorSize - 1u ) / model.sectorSize ) * model.sectorSize );
+      }
+
+      const size_t sectors = unitsTouched( address, length, model.sectorSize );
+      memset( memory + start, ERASED, end - start );
+
+      counters.erases++;
+      counters.sectorsErased += sectors;
+      counters.elapsedNs += model.transactionNs + ( static_cast<uint64_t>( model.eraseNs ) * sectors );
+
+      /*------------------------------------------------
+      Parts without an erase command simply get overwritten
+      ------------------------------------------------*/
+      if ( !model.sectorSize )
+      {
+        counters.elapsedNs += static_cast<uint64_t>( model.writeByteNs ) * length;
+      }
+
+      release();
+      result = Chimera::CommonStatusCodes::OK;
+    }
+
+    return result;
+  }
+
+  SimulatedStats SimulatedDevice::stats()
+  {
+    SimulatedStats result;
+
+    if ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK )
+    {
+      result = counters;
+      release();
+    }
+
+    return result;
+  }
+
+  void SimulatedDevice::resetStats()
+  {
+    if ( reserve( LOCK_TIMEOUT_MS ) == Chimera::CommonStatusCodes::OK )
+    {
+      counters = SimulatedStats();
+      release();
+    }
+  }
+
+  size_t SimulatedDevice::unitsTouched( const size_t address, const size_t length, const size_t unit )
+  {
+    size_t result = 0;
+
+    if ( unit && length )
+    {
+      result = ( ( address + length - 1u ) / unit ) - ( address / unit ) + 1u;
+    }
+
+    return result;
+  }
+
+}  // namespace AeroKernel::Parameter
+
+#endif /* __unix__ */
@@ -0,0 +1,208 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_sim.hpp
+ *
+ *  Description:
+ *    Host side memory device for benchmarking Parameter Manager storage
+ *    strategies without hardware. Memory lives in a file mapped into the
+ *    process, or in anonymous memory, and every transaction is charged against
+ *    a latency model of the part being imitated. Time is accumulated virtually
+ *    rather than slept, so results are fast and exactly reproducible.
+ *
+ *    Only available on hosts providing mmap().
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef AERO_KERNEL_PARAMETER_SIM_HPP
+#define AERO_KERNEL_PARAMETER_SIM_HPP
+
+#if defined( __unix__ )
+
+/* C++ Includes */
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/* AeroKernel Includes */
+#include <AeroKernel/parameter.hpp>
+
+/* Chimera Includes */
+#include <Chimera/modules/memory/device.hpp>
+#include <Chimera/threading.hpp>
+
+namespace AeroKernel::Parameter
+{
+  /**
+   *  Timing and behavior of a simulated memory part. All times are in
+   *  nanoseconds. The presets describe typical datasheet figures and are
+   *  meant as starting points, not as exact models of a specific chip.
+   */
+  struct LatencyModel
+  {
+    uint32_t transactionNs = 0;     /**< Fixed cost of every access, ie command, address and chip select */
+    uint32_t readByteNs    = 0;     /**< Cost of each byte read */
+    uint32_t writeByteNs   = 0;     /**< Cost of each byte transferred by a write */
+    uint32_t programSize   = 0;     /**< Program page size, zero if writes need no programming */
+    uint32_t programNs     = 0;     /**< Cost of programming each page a write touches */
+    uint32_t sectorSize    = 0;     /**< Erase sector size, zero if the part has no erase */
+    uint32_t eraseNs       = 0;     /**< Cost of erasing each sector */
+    bool flash             = false; /**< Writes can only clear bits, which only an erase sets again */
+
+    /**
+     *  SPI NOR flash on a single bit bus at 50MHz, ie W25Q series
+     */
+    static constexpr LatencyModel spiNor()
+    {
+      return { 1000, 160, 160, 256, 700000, 4096, 45000000, true };
+    }
+
+    /**
+     *  The same NOR array behind a quad SPI bus at 100MHz
+     */
+    static constexpr LatencyModel qspiNor()
+    {
+      return { 200, 20, 20, 256, 700000, 4096, 45000000, true };
+    }
+
+    /**
+     *  Microcontroller internal flash programmed a word at a time, ie STM32F4
+     */
+    static constexpr LatencyModel internalFlash()
+    {
+      return { 30, 6, 0, 4, 16000, 16384, 250000000, true };
+    }
+
+    /**
+     *  On chip SRAM behind the system bus
+     */
+    static constexpr LatencyModel sram()
+    {
+      return { 0, 1, 1, 0, 0, 0, 0, false };
+    }
+
+    /**
+     *  Picks the preset matching a Parameter Manager storage type. External
+     *  flash is assumed to be quad SPI and external SRAM a parallel bus.
+     *
+     *	@param[in]	storage     The storage type being simulated
+     *	@return LatencyModel
+     */
+    static LatencyModel forStorage( const StorageType storage );
+  };
+
+  /**
+   *  Counters kept by a SimulatedDevice
+   */
+  struct SimulatedStats
+  {
+    uint64_t reads           = 0; /**< Read transactions */
+    uint64_t writes          = 0; /**< Write transactions */
+    uint64_t erases          = 0; /**< Erase transactions */
+    uint64_t bytesRead       = 0;
+    uint64_t bytesWritten    = 0;
+    uint64_t pagesProgrammed = 0;
+    uint64_t sectorsErased   = 0;
+    uint64_t unerasedWrites  = 0; /**< Flash writes that tried to set a cleared bit, a sign of a missing erase */
+    uint64_t elapsedNs       = 0; /**< Virtual time spent in the device */
+  };
+
+  /**
+   *  Memory device backed by host memory with simulated timing. Addresses
+   *  start at zero and span the size given when the memory was attached.
+   *  Flash parts erase whole sectors, so an erase is widened to the sectors
+   *  it overlaps, and writes behave like the real part by ANDing into the
+   *  existing contents.
+   */
+  class SimulatedDevice : public Chimera::Modules::Memory::Device, public Chimera::Threading::Lockable
+  {
+  public:
+    SimulatedDevice( const LatencyModel &model );
+    ~SimulatedDevice();
+
+    /**
+     *	Attaches anonymous memory that starts out erased
+     *
+     *	@param[in]	size        Size of the memory in bytes
+     *	@return bool
+     */
+    bool open( const size_t size );
+
+    /**
+     *	Attaches a file, which is created erased if it does not exist. Changes
+     *  are written through to the file, so the contents survive across runs
+     *  just as non-volatile memory would.
+     *
+     *	@param[in]	path        The backing file
+     *	@param[in]	size        Size of the memory in bytes
+     *	@return bool
+     */
+    bool open( const std::string &path, const size_t size );
+
+    /**
+     *	Detaches the memory, syncing a backing file to disk
+     *
+     *	@return void
+     */
+    void close();
+
+    Chimera::Status_t write( const size_t address, const uint8_t *const data, const size_t length ) override;
+
+    Chimera::Status_t read( const size_t address, uint8_t *const data, const size_t length ) override;
+
+    Chimera::Status_t erase( const size_t address, const size_t length ) override;
+
+    /**
+     *	Gets a copy of the counters
+     *
+     *	@return SimulatedStats
+     */
+    SimulatedStats stats();
+
+    /**
+     *	Zeroes the counters and the virtual time
+     *
+     *	@return void
+     */
+    void resetStats();
+
+    /**
+     *	Gets the CPU address of the memory, which may be given to
+     *  Manager::registerDirectAccess() to simulate memory mapped storage
+     *
+     *	@return uint8_t *       nullptr if no memory is attached
+     */
+    uint8_t *base() const
+    {
+      return memory;
+    }
+
+    size_t size() const
+    {
+      return memorySize;
+    }
+
+  private:
+    static constexpr size_t LOCK_TIMEOUT_MS = 100;
+    static constexpr uint8_t ERASED         = 0xFF;
+
+    LatencyModel model;
+    SimulatedStats counters;
+    uint8_t *memory;
+    size_t memorySize;
+    int file;
+
+    /**
+     *	Counts the program pages or erase sectors touched by an access
+     */
+    static size_t unitsTouched( const size_t address, const size_t length, const size_t unit );
+  };
+
+  using SimulatedDevice_sPtr = std::shared_ptr<SimulatedDevice>;
+
+}  // namespace AeroKernel::Parameter
+
+#endif /* __unix__ */
+
+#endif /* !AERO_KERNEL_PARAMETER_SIM_HPP */
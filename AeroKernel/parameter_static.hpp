@@ -0,0 +1,385 @@
+/********************************************************************************
+ *  File Name:
+ *    parameter_static.hpp
+ *
+ *  Description:
+ *    Parameter Manager with its storage drivers bound at compile time. A flight
+ *    image has a fixed set of memories, so nothing is gained by looking drivers
+ *    up at runtime. Binding them by type lets typed accesses call the driver
+ *    directly, where the compiler can inline it, instead of copying a shared
+ *    pointer and making a virtual call on every transfer.
+ *
+ *  2019 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef AERO_KERNEL_PARAMETER_STATIC_HPP
+#define AERO_KERNEL_PARAMETER_STATIC_HPP
+
+/* C++ Includes */
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+/* AeroKernel Includes */
+#include <AeroKernel/parameter.hpp>
+
+/* Chimera Includes */
+#include <Chimera/modules/memory/device.hpp>
+
+namespace AeroKernel::Parameter
+{
+  /**
+   *  Binds a storage type to the concrete driver class that serves it
+   *
+   *	@tparam	S           The storage type
+   *	@tparam	DriverType  The driver class, which must derive from Chimera's memory Device and be final
+   */
+  template<StorageType S, typename DriverType>
+  struct Binding
+  {
+    static_assert( std::is_base_of_v<Chimera::Modules::Memory::Device, DriverType>, "Drivers must be memory devices" );
+    static_assert( std::is_final_v<DriverType>, "Drivers must be final so calls through them can be devirtualized" );
+    static_assert( ( S != StorageType::NONE ) && ( S < StorageType::MAX_STORAGE_OPTIONS ), "Invalid storage type" );
+
+    static constexpr StorageType storage = S;
+    using Driver                         = DriverType;
+  };
+
+  /**
+   *  A Manager whose drivers are fixed by its type, ie:
+   *
+   *    StaticManager<Binding<StorageType::INTERNAL_FLASH, FlashDriver>,
+   *                  Binding<StorageType::EXTERNAL_FLASH0, NorDriver>> params( flash, nor );
+   *
+   *  The drivers are owned by the application and must outlive the Manager.
+   *  Each driver class must be final, so an override can never be bypassed.
+   *  They are registered by init() and cannot be replaced afterwards. Typed
+   *  read<T>/write<T> calls on bound storage skip the driver lookup whenever
+   *  no cache, log store, open transaction or tier migration is involved, and
+   *  otherwise behave exactly as they do on the Manager. Everything else in
+   *  the Manager's interface is available unchanged.
+   */
+  template<typename... Bindings>
+  class StaticManager : public Manager
+  {
+  public:
+    static_assert( sizeof...( Bindings ) > 0, "Bind at least one driver" );
+
+    explicit StaticManager( typename Bindings::Driver &... drivers ) : StaticManager( 50, drivers... )
+    {
+    }
+
+    StaticManager( const size_t lockTimeout_mS, typename Bindings::Driver &... drivers ) :
+        Manager( lockTimeout_mS ), drivers( drivers... )
+    {
+    }
+
+    ~StaticManager() = default;
+
+    /**
+     *  Initializes the Manager as Manager::init() does, then registers the
+     *  bound drivers
+     *
+     *	@param[in]	numParameters   How many parameters can be managed by this class
+     *	@return bool
+     */
+    bool init( const size_t numParameters )
+    {
+      return Manager::init( numParameters ) && bindAll();
+    }
+
+    using Manager::read;
+    using Manager::write;
+
+    /**
+     *  Type safe parameter read, see Manager::read()
+     *
+     *	@param[in]	key             The parameter's name
+     *	@param[out]	value           Where to place the data
+     *	@return bool
+     */
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool read( const Key &key, T &value )
+    {
+      static_assert( std::is_trivially_copyable_v<T>, "Parameters are transferred as raw bytes" );
+      bool result = false;
+      RegistryLock lock;
+
+      if ( initialized && lockRegistry( key, lock ) )
+      {
+        result = readBound( findSlot( key ), value, lock );
+      }
+
+      return result;
+    }
+
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool read( const std::string_view &key, T &value )
+    {
+      return read( Key( key ), value );
+    }
+
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool read( const Handle handle, T &value )
+    {
+      static_assert( std::is_trivially_copyable_v<T>, "Parameters are transferred as raw bytes" );
+      bool result = false;
+      RegistryLock lock;
+
+      if ( initialized && lockRegistry( handle, lock ) )
+      {
+        result = readBound( activeSlot( handle ), value, lock );
+      }
+
+      return result;
+    }
+
+    /**
+     *  Type safe parameter write, see Manager::write()
+     *
+     *	@param[in]	key             The parameter's name
+     *	@param[in]	value           The data to write
+     *	@return bool
+     */
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool write( const Key &key, const T &value )
+    {
+      static_assert( std::is_trivially_copyable_v<T>, "Parameters are transferred as raw bytes" );
+      bool result = false;
+      RegistryLock lock;
+
+      if ( initialized && lockRegistry( key, lock ) )
+      {
+        result = writeBound( findSlot( key ), value, lock );
+      }
+
+      return result;
+    }
+
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool write( const std::string_view &key, const T &value )
+    {
+      return write( Key( key ), value );
+    }
+
+    template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T> && !std::is_array_v<T>>>
+    bool write( const Handle handle, const T &value )
+    {
+      static_assert( std::is_trivially_copyable_v<T>, "Parameters are transferred as raw bytes" );
+      bool result = false;
+      RegistryLock lock;
+
+      if ( initialized && lockRegistry( handle, lock ) )
+      {
+        result = writeBound( activeSlot( handle ), value, lock );
+      }
+
+      return result;
+    }
+
+    /**
+     *  Gets the driver bound to a storage type
+     *
+     *	@tparam	S           The storage type
+     *	@return Driver &
+     */
+    template<StorageType S>
+    auto &driver()
+    {
+      static_assert( indexOf<S>() < sizeof...( Bindings ), "Storage type is not bound" );
+      return std::get<indexOf<S>()>( drivers );
+    }
+
+  private:
+    static_assert( [] {
+      constexpr StorageType bound[] = { Bindings::storage... };
+      bool unique                   = true;
+
+      for ( size_t x = 0; x < sizeof...( Bindings ); x++ )
+      {
+        for ( size_t y = x + 1u; y < sizeof...( Bindings ); y++ )
+        {
+          unique &= ( bound[ x ] != bound[ y ] );
+        }
+      }
+
+      return unique;
+    }(), "A storage type can only be bound once" );
+
+    std::tuple<typename Bindings::Driver &...> drivers;
+
+    template<StorageType S>
+    static constexpr size_t indexOf()
+    {
+      constexpr StorageType bound[] = { Bindings::storage... };
+      size_t result                 = sizeof...( Bindings );
+
+      for ( size_t x = 0; x < sizeof...( Bindings ); x++ )
+      {
+        if ( ( bound[ x ] == S ) && ( result == sizeof...( Bindings ) ) )
+        {
+          result = x;
+        }
+      }
+
+      return result;
+    }
+
+    /**
+     *  Registers every bound driver. A driver reference is wrapped in a
+     *  pointer that owns nothing, which the Manager can copy freely.
+     */
+    template<size_t I = 0>
+    bool bindAll()
+    {
+      bool result = true;
+
+      if constexpr ( I < sizeof...( Bindings ) )
+      {
+        using Bound = std::tuple_element_t<I, std::tuple<Bindings...>>;
+
+        Chimera::Modules::Memory::Device_sPtr device( Chimera::Modules::Memory::Device_sPtr(), &std::get<I>( drivers ) );
+        result = bindMemoryDriver( Bound::storage, device ) && bindAll<I + 1>();
+      }
+
+      return result;
+    }
+
+    /**
+     *  Calls the read or write of the driver bound to a storage type. Bound
+     *  drivers are final, so the call resolves at compile time rather than
+     *  through the vtable.
+     */
+    template<size_t I = 0>
+    Chimera::Status_t boundRead( const StorageType storage, const size_t address, uint8_t *const data, const size_t length )
+    {
+      Chimera::Status_t result = Chimera::CommonStatusCodes::FAIL;
+
+      if constexpr ( I < sizeof...( Bindings ) )
+      {
+        using Bound = std::tuple_element_t<I, std::tuple<Bindings...>>;
+
+        if ( storage == Bound::storage )
+        {
+          result = std::get<I>( drivers ).read( address, data, length );
+        }
+        else
+        {
+          result = boundRead<I + 1>( storage, address, data, length );
+        }
+      }
+
+      return result;
+    }
+
+    template<size_t I = 0>
+    Chimera::Status_t boundWrite( const StorageType storage, const size_t address, const uint8_t *const data,
+                                  const size_t length )
+    {
+      Chimera::Status_t result = Chimera::CommonStatusCodes::FAIL;
+
+      if constexpr ( I < sizeof...( Bindings ) )
+      {
+        using Bound = std::tuple_element_t<I, std::tuple<Bindings...>>;
+
+        if ( storage == Bound::storage )
+        {
+          result = std::get<I>( drivers ).write( address, data, length );
+        }
+        else
+        {
+          result = boundWrite<I + 1>( storage, address, data, length );
+        }
+      }
+
+      return result;
+    }
+
+    /**
+     *  Typed transfer that prefers the bound driver. Follows the same registry
+     *  locking contract as Manager::readTyped/writeTyped, which handle anything
+     *  the bound driver can't.
+     */
+    template<typename T>
+    bool readBound( const uint16_t slot, T &value, const RegistryLock &lock )
+    {
+      bool result               = false;
+      size_t address            = 0;
+      const StorageType storage = directAddress( slot, sizeof( T ), false ) ? StorageType::NONE
+                                                                             : plainAccess( slot, sizeof( T ), false, address );
+
+      if ( storage != StorageType::NONE )
+      {
+        uint32_t sequence    = 0;
+        uint32_t version     = 0;
+        const bool sequenced = isSequenced( slot );
+
+        countAccess( slot, false );
+        unlockRegistry( lock );
+
+        do
+        {
+          sequence = readBegin();
+          version  = sequenced ? slotReadBegin( slot ) : 0u;
+          result   = lockDriver( storage );
+
+          if ( result )
+          {
+            result = ( boundRead( storage, address, reinterpret_cast<uint8_t *>( &value ), sizeof( T ) )
+                       == Chimera::CommonStatusCodes::OK );
+            unlockDriver( storage );
+          }
+        } while ( !readValidate( sequence ) || ( sequenced && !slotReadValidate( slot, version ) ) );
+      }
+      else
+      {
+        result = readTyped( slot, value, lock );
+      }
+
+      return result;
+    }
+
+    template<typename T>
+    bool writeBound( const uint16_t slot, const T &value, const RegistryLock &lock )
+    {
+      bool result               = false;
+      size_t address            = 0;
+      const StorageType storage = directAddress( slot, sizeof( T ), true ) ? StorageType::NONE
+                                                                            : plainAccess( slot, sizeof( T ), true, address );
+
+      if ( storage != StorageType::NONE )
+      {
+        const bool sequenced = isSequenced( slot );
+
+        countAccess( slot, true );
+        unlockRegistry( lock );
+
+        if ( sequenced )
+        {
+          slotWriteBegin( slot );
+        }
+
+        if ( lockDriver( storage ) )
+        {
+          result = ( boundWrite( storage, address, reinterpret_cast<const uint8_t *>( &value ), sizeof( T ) )
+                     == Chimera::CommonStatusCodes::OK );
+          unlockDriver( storage );
+        }
+
+        if ( sequenced )
+        {
+          slotWriteEnd( slot );
+        }
+      }
+      else
+      {
+        result = writeTyped( slot, value, lock );
+      }
+
+      return result;
+    }
+  };
+}  // namespace AeroKernel::Parameter
+
+#endif /* !AERO_KERNEL_PARAMETER_STATIC_HPP */